@@ -126,6 +126,15 @@
 #define RIPPLE_DUMP_LEAKS_ON_EXIT 1
 #endif
 
+/** Config: RIPPLE_COUNT_ALLOCATIONS
+    Replaces the global operator new with one that counts calls and
+    bytes, so that benchmarks can report allocations. Every allocation then pays
+    for an atomic increment, so normally this is turned off.
+*/
+#ifndef RIPPLE_COUNT_ALLOCATIONS
+//#define RIPPLE_COUNT_ALLOCATIONS 1
+#endif
+
 //------------------------------------------------------------------------------
 
 // These control whether or not certain functionality gets
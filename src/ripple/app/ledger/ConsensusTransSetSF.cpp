@@ -56,9 +56,9 @@ void ConsensusTransSetSF::gotNode (
         try
         {
             // skip prefix
-            Serializer s (nodeData.data() + 4, nodeData.size() - 4);
-            SerialIter sit (s.slice());
-            auto stx = std::make_shared<STTx const> (std::ref (sit));
+            auto stx = app_.getMasterTransaction().parse (
+                nodeHash.as_uint256(),
+                    Slice (nodeData.data() + 4, nodeData.size() - 4));
             assert (stx->getTransactionID () == nodeHash.as_uint256());
             auto const pap = &app_;
             app_.getJobQueue ().addJob (
@@ -51,6 +51,7 @@
 #include <ripple/beast/core/LexicalCast.h>
 #include <ripple/beast/unit_test.h>
 #include <boost/optional.hpp>
+#include <algorithm>
 #include <cassert>
 #include <utility>
 
@@ -437,6 +438,24 @@ boost::optional<uint256>
 Ledger::succ (uint256 const& key,
     boost::optional<uint256> const& last) const
 {
+    // Walking an order book asks for the next directory before
+    // the end of the book's quality range. An immutable ledger
+    // answers those from a list of the book's directories, so
+    // every view built on it shares one walk of the state map.
+    if (mImmutable && last)
+    {
+        auto const base = getQualityIndex (key);
+        if (*last == getQualityNext (base))
+        {
+            auto const dirs = bookDirs (base);
+            auto const iter = std::upper_bound (
+                dirs->begin(), dirs->end(), key);
+            if (iter == dirs->end())
+                return boost::none;
+            return *iter;
+        }
+    }
+
     auto item = stateMap_->upper_bound(key);
     if (item == stateMap_->end())
         return boost::none;
@@ -445,6 +464,35 @@ Ledger::succ (uint256 const& key,
     return item->key();
 }
 
+std::shared_ptr<std::vector<uint256> const>
+Ledger::bookDirs (uint256 const& base) const
+{
+    {
+        std::lock_guard<std::mutex> lock (bookDirsLock_);
+        auto const iter = bookDirs_.find (base);
+        if (iter != bookDirs_.end())
+            return iter->second;
+    }
+
+    auto const end = getQualityNext (base);
+    auto dirs = std::make_shared<std::vector<uint256>>();
+    if (stateMap_->hasItem (base))
+        dirs->push_back (base);
+    for (auto iter = stateMap_->upper_bound (base);
+        iter != stateMap_->end() && iter->key() < end; ++iter)
+    {
+        dirs->push_back (iter->key());
+    }
+
+    // A book with at most one directory is found as quickly without
+    // a list. The number of lists is bounded, as the ledger may be
+    // held long after pathfinding is done with it.
+    std::lock_guard<std::mutex> lock (bookDirsLock_);
+    if (dirs->size() < 2 || bookDirs_.size() >= maxBookDirs)
+        return dirs;
+    return bookDirs_.emplace (base, std::move (dirs)).first->second;
+}
+
 std::shared_ptr<SLE const>
 Ledger::read (Keylet const& k) const
 {
@@ -24,6 +24,7 @@
 #include <ripple/ledger/View.h>
 #include <ripple/ledger/CachedView.h>
 #include <ripple/basics/CountedObject.h>
+#include <ripple/basics/UnorderedContainers.h>
 #include <ripple/core/TimeKeeper.h>
 #include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/STLedgerEntry.h>
@@ -33,6 +34,7 @@
 #include <ripple/beast/utility/Journal.h>
 #include <boost/optional.hpp>
 #include <mutex>
+#include <vector>
 
 namespace ripple {
 
@@ -327,6 +329,9 @@ private:
     void
     updateHash();
 
+    std::shared_ptr<std::vector<uint256> const>
+    bookDirs (uint256 const& base) const;
+
     bool mValidHash = false;
     bool mImmutable;
 
@@ -336,6 +341,13 @@ private:
     // Protects fee variables
     std::mutex mutable mutex_;
 
+    // The directory keys in each order book that has been walked,
+    // in quality order. Only filled once the ledger is immutable.
+    static std::size_t const maxBookDirs = 4096;
+    std::mutex mutable bookDirsLock_;
+    hash_map<uint256,
+        std::shared_ptr<std::vector<uint256> const>> mutable bookDirs_;
+
     Fees fees_;
     Rules rules_;
     LedgerInfo info_;
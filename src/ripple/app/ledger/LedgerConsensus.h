@@ -109,6 +109,38 @@ int applyTransaction (
     ApplyFlags flags,
     beast::Journal j);
 
+/** Apply a sequence of transactions to a ledger, using several threads
+
+    Each transaction is first applied on its own to a private view of
+    `view`, recording the entries it reads and writes. The results are
+    then committed in order. A transaction is applied again, serially,
+    if it touches an entry changed by an earlier transaction in its
+    batch, depends on the order of keys, or if an earlier transaction
+    did not apply. The view ends up exactly as if each transaction had
+    been passed to applyTransaction in turn.
+
+    The speculative applies run as jobs on the job queue, so no more
+    run at once than the queue has threads.
+
+  @param view                   The view to apply to
+  @param txns                   The transactions, in the order to apply
+  @param retryAssured           True if another pass is assured
+  @param flags                  Flags for transactor
+  @param threads                The number of jobs to apply with,
+                                including the calling thread
+  @return                       For each transaction, resultSuccess,
+                                resultFail or resultRetry
+*/
+std::vector<int>
+applyTransactionsParallel (
+    Application& app,
+    OpenView& view,
+    std::vector<std::shared_ptr<STTx const>> const& txns,
+    bool retryAssured,
+    ApplyFlags flags,
+    std::size_t threads,
+    beast::Journal j);
+
 } // ripple
 
 #endif
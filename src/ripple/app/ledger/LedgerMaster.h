@@ -36,6 +36,8 @@
 #include <ripple/core/Stoppable.h>
 #include <ripple/beast/utility/PropertyStream.h>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include "ripple.pb.h"
 
@@ -228,10 +230,21 @@ public:
         bool progress,
         std::uint32_t seq);
 
+    /** Add a node whose hash was computed from its data. */
     void addFetchPack (
         uint256 const& hash,
         std::shared_ptr<Blob>& data);
 
+    /** Add nodes received from a peer.
+
+        The claimed hashes are checked against the data in
+        batches and nodes that do not match are dropped.
+
+        @return The number of nodes added.
+    */
+    std::size_t addFetchPacks (
+        std::vector<std::pair<uint256, std::shared_ptr<Blob>>>& packs);
+
     bool getFetchPack (
         uint256 const& hash,
         Blob& data);
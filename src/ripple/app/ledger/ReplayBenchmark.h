@@ -0,0 +1,60 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_APP_LEDGER_REPLAYBENCHMARK_H_INCLUDED
+#define RIPPLE_APP_LEDGER_REPLAYBENCHMARK_H_INCLUDED
+
+#include <ripple/app/main/Application.h>
+#include <ripple/json/json_value.h>
+#include <ripple/beast/utility/Journal.h>
+#include <cstdint>
+
+namespace ripple {
+
+/** Rebuild a range of stored ledgers and time the transaction engine.
+
+    Each ledger in [first, last] is rebuilt on top of its stored parent
+    by applying the stored transactions in their original order, the
+    same way a replayed consensus round does. The rebuilt ledger hash is
+    compared against the stored one.
+
+    Both the ledgers and their parents must be present in the local
+    ledger and node databases. No network access is needed.
+
+    If [apply_threads] is configured, each ledger is applied with
+    applyTransactionsParallel instead, and only the overall
+    throughput is reported.
+
+    When built with RIPPLE_COUNT_ALLOCATIONS, the mean number of
+    allocations and bytes allocated per transaction are reported
+    for each transaction type as well.
+
+    @return A report with the overall throughput, the per transaction
+            type latency and the sequence of every ledger whose rebuilt
+            hash did not match.
+*/
+Json::Value
+replayLedgerRange (Application& app,
+    std::uint32_t first, std::uint32_t last,
+        beast::Journal j);
+
+} // ripple
+
+#endif
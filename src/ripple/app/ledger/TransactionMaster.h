@@ -20,6 +20,7 @@
 #ifndef RIPPLE_APP_LEDGER_TRANSACTIONMASTER_H_INCLUDED
 #define RIPPLE_APP_LEDGER_TRANSACTIONMASTER_H_INCLUDED
 
+#include <ripple/basics/TaggedCache.h>
 #include <ripple/shamap/SHAMapItem.h>
 #include <ripple/shamap/SHAMapTreeNode.h>
 
@@ -46,6 +47,27 @@ public:
         SHAMapTreeNode::TNType type, bool checkDisk,
             std::uint32_t uCommitLedger);
 
+    /** Return the parsed form of a serialized transaction.
+
+        Parsed transactions are shared by every caller asking
+        for the same ID, so a transaction which arrives from a
+        peer, appears in a proposed set and is applied during
+        consensus is only deserialized once while it is in use.
+
+        @param txnID The ID of the transaction.
+        @param data The serialized transaction, without a prefix.
+        @throws std::exception if the transaction is malformed.
+    */
+    std::shared_ptr<STTx const>
+    parse (uint256 const& txnID, Slice const& data);
+
+    /** Return the parsed form of a serialized transaction.
+
+        As above, but the ID is computed from the data.
+    */
+    std::shared_ptr<STTx const>
+    parse (Slice const& data);
+
     // return value: true = we had the transaction already
     bool inLedger (uint256 const& hash, std::uint32_t ledger);
 
@@ -56,9 +78,13 @@ public:
     TaggedCache <uint256, Transaction>&
     getCache();
 
+    TaggedCache <uint256, STTx const>&
+    getParsedCache();
+
 private:
     Application& mApp;
     TaggedCache <uint256, Transaction> mCache;
+    TaggedCache <uint256, STTx const> mParsedCache;
 };
 
 } // ripple
@@ -546,7 +546,7 @@ void InboundLedger::trigger (Peer::ptr const& peer, TriggerReason reason)
             // Release the lock while we process the large state map
             sl.unlock();
             auto nodes = mLedger->stateMap().getMissingNodes (
-                missingNodesFind, &filter);
+                missingNodesFind, &filter, m_journal);
             sl.lock();
 
             // Make sure nothing happened while we released the lock
@@ -617,7 +617,7 @@ void InboundLedger::trigger (Peer::ptr const& peer, TriggerReason reason)
             TransactionStateSF filter(app_);
 
             auto nodes = mLedger->txMap().getMissingNodes (
-                missingNodesFind, &filter);
+                missingNodesFind, &filter, m_journal);
 
             if (nodes.empty ())
             {
@@ -24,6 +24,7 @@
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/app/ledger/LocalTxs.h>
 #include <ripple/app/ledger/OpenLedger.h>
+#include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/ledger/impl/DisputedTx.h>
 #include <ripple/app/ledger/impl/LedgerConsensusImp.h>
 #include <ripple/app/ledger/impl/TransactionAcquire.h>
@@ -1119,9 +1120,8 @@ void LedgerConsensusImp::accept (std::shared_ptr<SHAMap> set)
                     JLOG (j_.debug())
                         << "Test applying disputed transaction that did"
                         << " not get in";
-                    SerialIter sit (it.second->peekTransaction().slice());
-
-                    auto txn = std::make_shared<STTx const>(sit);
+                    auto txn = app_.getMasterTransaction().parse (
+                        it.first, it.second->peekTransaction().slice());
 
                     retriableTxs.insert (txn);
 
@@ -2003,7 +2003,8 @@ void applyTransactions (
             std::shared_ptr<STTx const> txn;
             try
             {
-                txn = std::make_shared<STTx const>(SerialIter{item.slice()});
+                txn = app.getMasterTransaction().parse (
+                    item.key(), item.slice());
             }
             catch (std::exception const&)
             {
@@ -2029,31 +2030,56 @@ void applyTransactions (
 
         auto it = retriableTxs.begin ();
 
-        while (it != retriableTxs.end ())
+        if (app.config().APPLY_THREADS > 1)
         {
-            try
-            {
-                switch (applyTransaction (app, view,
-                    it->second, certainRetry, flags, j))
-                {
-                case LedgerConsensusImp::resultSuccess:
-                    it = retriableTxs.erase (it);
-                    ++changes;
-                    break;
+            std::vector<std::shared_ptr<STTx const>> txns;
+            txns.reserve (retriableTxs.size ());
+            for (auto const& item : retriableTxs)
+                txns.push_back (item.second);
 
-                case LedgerConsensusImp::resultFail:
-                    it = retriableTxs.erase (it);
-                    break;
+            auto const results = applyTransactionsParallel (app, view,
+                txns, certainRetry, flags, app.config().APPLY_THREADS, j);
 
-                case LedgerConsensusImp::resultRetry:
+            for (auto const result : results)
+            {
+                if (result == LedgerConsensusImp::resultRetry)
+                {
                     ++it;
+                    continue;
                 }
+                if (result == LedgerConsensusImp::resultSuccess)
+                    ++changes;
+                it = retriableTxs.erase (it);
             }
-            catch (std::exception const&)
+        }
+        else
+        {
+            while (it != retriableTxs.end ())
             {
-                JLOG (j.warn())
-                    << "Transaction throws";
-                it = retriableTxs.erase (it);
+                try
+                {
+                    switch (applyTransaction (app, view,
+                        it->second, certainRetry, flags, j))
+                    {
+                    case LedgerConsensusImp::resultSuccess:
+                        it = retriableTxs.erase (it);
+                        ++changes;
+                        break;
+
+                    case LedgerConsensusImp::resultFail:
+                        it = retriableTxs.erase (it);
+                        break;
+
+                    case LedgerConsensusImp::resultRetry:
+                        ++it;
+                    }
+                }
+                catch (std::exception const&)
+                {
+                    JLOG (j.warn())
+                        << "Transaction throws";
+                    it = retriableTxs.erase (it);
+                }
             }
         }
 
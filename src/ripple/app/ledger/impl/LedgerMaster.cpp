@@ -1773,6 +1773,33 @@ LedgerMaster::addFetchPack (
     fetch_packs_.canonicalize (hash, data);
 }
 
+std::size_t
+LedgerMaster::addFetchPacks (
+    std::vector<std::pair<uint256, std::shared_ptr<Blob>>>& packs)
+{
+    std::vector<beast::sha512_message> messages;
+    messages.reserve (packs.size());
+    for (auto const& pack : packs)
+        messages.emplace_back (pack.second->data(), pack.second->size());
+
+    std::vector<uint256> hashes (packs.size());
+    sha512HalfMulti (messages.data(), messages.size(), hashes.data());
+
+    std::size_t added = 0;
+    for (std::size_t i = 0; i < packs.size(); ++i)
+    {
+        if (hashes[i] != packs[i].first)
+        {
+            JLOG (m_journal.warn()) <<
+                "Fetch pack node " << packs[i].first << " has bad hash";
+            continue;
+        }
+        fetch_packs_.canonicalize (packs[i].first, packs[i].second);
+        ++added;
+    }
+    return added;
+}
+
 bool
 LedgerMaster::getFetchPack (
     uint256 const& hash,
@@ -1783,7 +1810,8 @@ LedgerMaster::getFetchPack (
 
     fetch_packs_.del (hash, false);
 
-    return hash == sha512Half(makeSlice(data));
+    // Every node was checked against its hash when it was added
+    return true;
 }
 
 void
@@ -0,0 +1,341 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/app/ledger/LedgerConsensus.h>
+#include <ripple/app/ledger/impl/LedgerConsensusImp.h>
+#include <ripple/basics/Log.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/core/ParallelFor.h>
+#include <ripple/ledger/OpenView.h>
+#include <algorithm>
+
+namespace ripple {
+
+namespace detail {
+
+// Forwards to a view, remembering which keys were looked at
+class RecordingReadView
+    : public ReadView
+{
+private:
+    ReadView const& base_;
+    mutable std::vector<key_type> keys_;
+    mutable bool ordered_ = false;
+
+public:
+    explicit
+    RecordingReadView (ReadView const& base)
+        : base_ (base)
+    {
+    }
+
+    /** The keys read through this view. */
+    std::vector<key_type> const&
+    keys() const
+    {
+        return keys_;
+    }
+
+    /** True if a result depended on the order of keys.
+
+        The outcome of succ and iteration depends on
+        keys other than the ones returned, so reads
+        alone cannot tell whether they are stale.
+    */
+    bool
+    ordered() const
+    {
+        return ordered_;
+    }
+
+    LedgerInfo const&
+    info() const override
+    {
+        return base_.info();
+    }
+
+    bool
+    open() const override
+    {
+        return base_.open();
+    }
+
+    Fees const&
+    fees() const override
+    {
+        return base_.fees();
+    }
+
+    Rules const&
+    rules() const override
+    {
+        return base_.rules();
+    }
+
+    bool
+    exists (Keylet const& k) const override
+    {
+        keys_.push_back (k.key);
+        return base_.exists (k);
+    }
+
+    boost::optional<key_type>
+    succ (key_type const& key, boost::optional<
+        key_type> const& last = boost::none) const override
+    {
+        ordered_ = true;
+        return base_.succ (key, last);
+    }
+
+    std::shared_ptr<SLE const>
+    read (Keylet const& k) const override
+    {
+        keys_.push_back (k.key);
+        return base_.read (k);
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override
+    {
+        ordered_ = true;
+        return base_.slesBegin();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override
+    {
+        ordered_ = true;
+        return base_.slesEnd();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound (key_type const& key) const override
+    {
+        ordered_ = true;
+        return base_.slesUpperBound (key);
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override
+    {
+        return base_.txsBegin();
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override
+    {
+        return base_.txsEnd();
+    }
+
+    bool
+    txExists (key_type const& key) const override
+    {
+        return base_.txExists (key);
+    }
+
+    tx_type
+    txRead (key_type const& key) const override
+    {
+        return base_.txRead (key);
+    }
+};
+
+// Collects the keys of raw modifications without applying them
+class RecordingRawView
+    : public TxsRawView
+{
+private:
+    std::vector<uint256>& keys_;
+
+public:
+    explicit
+    RecordingRawView (std::vector<uint256>& keys)
+        : keys_ (keys)
+    {
+    }
+
+    void
+    rawErase (std::shared_ptr<SLE> const& sle) override
+    {
+        keys_.push_back (sle->key());
+    }
+
+    void
+    rawInsert (std::shared_ptr<SLE> const& sle) override
+    {
+        keys_.push_back (sle->key());
+    }
+
+    void
+    rawReplace (std::shared_ptr<SLE> const& sle) override
+    {
+        keys_.push_back (sle->key());
+    }
+
+    void
+    rawDestroyXRP (XRPAmount const&) override
+    {
+    }
+
+    void
+    rawTxInsert (ReadView::key_type const&,
+        std::shared_ptr<Serializer const> const&,
+            std::shared_ptr<Serializer const> const&) override
+    {
+    }
+};
+
+// The result of applying one transaction in isolation
+struct Speculation
+{
+    std::unique_ptr<RecordingReadView> reads;
+    std::unique_ptr<OpenView> view;
+    int result = LedgerConsensusImp::resultFail;
+};
+
+} // detail
+
+std::vector<int>
+applyTransactionsParallel (
+    Application& app,
+    OpenView& view,
+    std::vector<std::shared_ptr<STTx const>> const& txns,
+    bool retryAssured,
+    ApplyFlags flags,
+    std::size_t threads,
+    beast::Journal j)
+{
+    std::vector<int> results (txns.size(),
+        LedgerConsensusImp::resultFail);
+
+    // Pseudo-transactions change server state
+    // as well as the ledger, so never speculate.
+    auto const serialOnly = [](STTx const& tx)
+    {
+        auto const type = tx.getTxnType();
+        return type == ttAMENDMENT || type == ttFEE;
+    };
+
+    std::size_t const batchSize = std::max<std::size_t> (threads, 1) * 8;
+    std::size_t next = 0;
+    std::size_t speculated = 0;
+    std::size_t replayed = 0;
+
+    while (next < txns.size())
+    {
+        if (threads < 2 || serialOnly (*txns[next]))
+        {
+            results[next] = applyTransaction (app, view,
+                txns[next], retryAssured, flags, j);
+            ++next;
+            continue;
+        }
+
+        // Apply each tx in the batch to its own view of the current
+        // state, numbered as if every earlier one had been applied.
+        auto const first = next;
+        auto last = first;
+        while (last < txns.size() &&
+                last - first < batchSize &&
+                ! serialOnly (*txns[last]))
+            ++last;
+
+        std::vector<detail::Speculation> batch (last - first);
+        auto const baseCount = view.txCount();
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            batch[i].reads =
+                std::make_unique<detail::RecordingReadView> (view);
+            batch[i].view = std::make_unique<OpenView> (
+                batch[i].reads.get(), baseCount + i);
+        }
+
+        parallelFor (app.getJobQueue(), jtACCEPT,
+            "applyTransactionsParallel", batch.size(), threads,
+            [&](std::size_t i)
+            {
+                batch[i].result = applyTransaction (app,
+                    *batch[i].view, txns[first + i],
+                        retryAssured, flags, j);
+            });
+
+        // Commit in order until a result might differ from what
+        // serial application would have produced.
+        hash_set<uint256> written;
+        std::vector<uint256> writes;
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            auto& s = batch[i];
+            next = first + i + 1;
+
+            bool valid = ! s.reads->ordered() &&
+                view.txCount() == baseCount + i;
+
+            if (valid)
+            {
+                writes.clear();
+                detail::RecordingRawView collect (writes);
+                s.view->apply (collect);
+
+                auto const touched = [&written](uint256 const& key)
+                {
+                    return written.count (key) != 0;
+                };
+                valid =
+                    std::none_of (s.reads->keys().begin(),
+                        s.reads->keys().end(), touched) &&
+                    std::none_of (writes.begin(),
+                        writes.end(), touched);
+            }
+
+            if (! valid)
+            {
+                // The remaining results were computed against
+                // state or tx numbering that is now out of date.
+                results[first + i] = applyTransaction (app, view,
+                    txns[first + i], retryAssured, flags, j);
+                ++replayed;
+                break;
+            }
+
+            results[first + i] = s.result;
+            ++speculated;
+
+            if (s.result != LedgerConsensusImp::resultSuccess)
+            {
+                // Nothing to commit, but later tx
+                // were numbered assuming this applied.
+                break;
+            }
+
+            s.view->apply (view);
+            written.insert (writes.begin(), writes.end());
+        }
+    }
+
+    JLOG (j.debug()) <<
+        "Parallel apply: " << txns.size() << " txns, " <<
+        speculated << " speculative, " << replayed << " replayed";
+
+    return results;
+}
+
+} // ripple
@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/app/ledger/ReplayBenchmark.h>
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/LedgerConsensus.h>
+#include <ripple/basics/AllocationCounter.h>
+#include <ripple/basics/Log.h>
+#include <ripple/ledger/OpenView.h>
+#include <ripple/protocol/TxFormats.h>
+#include <ripple/shamap/SHAMapMissingNode.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+namespace ripple {
+
+namespace {
+
+struct TxTypeStats
+{
+    std::uint64_t count = 0;
+    std::chrono::nanoseconds total {0};
+    std::chrono::nanoseconds max {0};
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+};
+
+std::string
+txTypeName (TxType type)
+{
+    if (auto const item = TxFormats::getInstance ().findByType (type))
+        return item->getName ();
+    return std::to_string (static_cast<int> (type));
+}
+
+double
+toMicroseconds (std::chrono::nanoseconds d)
+{
+    return std::chrono::duration<double, std::micro> (d).count ();
+}
+
+} // anonymous
+
+Json::Value
+replayLedgerRange (Application& app,
+    std::uint32_t first, std::uint32_t last,
+        beast::Journal j)
+{
+    using clock_type = std::chrono::steady_clock;
+
+    Json::Value report (Json::objectValue);
+    Json::Value& mismatched = (report["mismatched"] = Json::arrayValue);
+
+    std::map <TxType, TxTypeStats> byType;
+    std::uint64_t transactions = 0;
+    std::uint32_t ledgers = 0;
+    clock_type::duration applyTime {0};
+
+    auto const threads = app.config().APPLY_THREADS;
+
+    auto const start = clock_type::now ();
+    try
+    {
+        std::shared_ptr<Ledger const> parent =
+            (first > 1) ? loadByIndex (first - 1, app) : nullptr;
+
+        for (auto seq = first; seq <= last; ++seq)
+        {
+            std::shared_ptr<Ledger const> const target =
+                loadByIndex (seq, app);
+
+            if (! parent || ! target)
+            {
+                JLOG (j.fatal()) <<
+                    "Replay: ledger " << (parent ? seq : seq - 1) <<
+                    " is not in the local database";
+                report["error"] = "ledgerNotFound";
+                break;
+            }
+
+            // Apply in the order the transactions were
+            // originally applied, as LedgerReplay does.
+            std::map <int, std::shared_ptr<STTx const>> txns;
+            for (auto const& item : target->txs)
+                txns.emplace ((*item.second)[sfTransactionIndex],
+                    item.first);
+
+            auto built = std::make_shared<Ledger> (
+                *parent, target->info().closeTime);
+            {
+                OpenView accum (&*built);
+                if (threads > 1)
+                {
+                    // Individual latencies are not meaningful here
+                    std::vector<std::shared_ptr<STTx const>> batch;
+                    batch.reserve (txns.size ());
+                    for (auto const& tx : txns)
+                        batch.push_back (tx.second);
+
+                    auto const t0 = clock_type::now ();
+                    applyTransactionsParallel (app, accum, batch,
+                        false, tapNO_CHECK_SIGN, threads, j);
+                    applyTime += clock_type::now () - t0;
+                }
+                else
+                {
+                    for (auto const& tx : txns)
+                    {
+                        AllocationCounter allocations;
+                        auto const t0 = clock_type::now ();
+                        applyTransaction (app, accum, tx.second,
+                            false, tapNO_CHECK_SIGN, j);
+                        auto const elapsed = clock_type::now () - t0;
+
+                        auto& stats = byType[tx.second->getTxnType ()];
+                        ++stats.count;
+                        stats.total += elapsed;
+                        stats.allocations += allocations.count ();
+                        stats.bytes += allocations.bytes ();
+                        stats.max = std::max <std::chrono::nanoseconds> (
+                            stats.max, elapsed);
+                        applyTime += elapsed;
+                    }
+                }
+                accum.apply (*built);
+            }
+            built->updateSkipList ();
+            built->setAccepted (target->info().closeTime,
+                target->info().closeTimeResolution,
+                getCloseAgree (target->info()),
+                app.config ());
+
+            if (built->info().hash != target->info().hash)
+            {
+                JLOG (j.warn()) <<
+                    "Replay: ledger " << seq << " rebuilt as " <<
+                    built->info().hash << " expected " <<
+                    target->info().hash;
+                mismatched.append (seq);
+            }
+
+            transactions += txns.size ();
+            ++ledgers;
+
+            // Continue from the stored ledger so that
+            // one mismatch does not spoil the rest.
+            parent = target;
+        }
+    }
+    catch (SHAMapMissingNode const& e)
+    {
+        JLOG (j.fatal()) << "Replay: " << e;
+        report["error"] = "missingNode";
+    }
+
+    auto const elapsed = clock_type::now () - start;
+    auto const seconds =
+        std::chrono::duration<double> (applyTime).count ();
+
+    report["apply_threads"] = static_cast<Json::UInt> (threads);
+    report["ledgers"] = ledgers;
+    report["transactions"] = static_cast<Json::UInt> (transactions);
+    report["elapsed_ms"] = static_cast<Json::UInt> (
+        std::chrono::duration_cast<
+            std::chrono::milliseconds> (elapsed).count ());
+    report["apply_ms"] = static_cast<Json::UInt> (
+        std::chrono::duration_cast<
+            std::chrono::milliseconds> (applyTime).count ());
+    if (seconds > 0)
+        report["tx_per_second"] = transactions / seconds;
+
+    Json::Value& types = (report["types"] = Json::objectValue);
+    for (auto const& s : byType)
+    {
+        Json::Value& entry = types[txTypeName (s.first)];
+        entry["count"] = static_cast<Json::UInt> (s.second.count);
+        entry["mean_us"] = toMicroseconds (s.second.total) / s.second.count;
+        entry["max_us"] = toMicroseconds (s.second.max);
+        if (AllocationCounter::enabled ())
+        {
+            entry["mean_allocations"] = static_cast<Json::UInt> (
+                s.second.allocations / s.second.count);
+            entry["mean_bytes"] = static_cast<Json::UInt> (
+                s.second.bytes / s.second.count);
+        }
+    }
+
+    return report;
+}
+
+} // ripple
@@ -21,6 +21,8 @@
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/chrono.h>
@@ -31,6 +33,8 @@ TransactionMaster::TransactionMaster (Application& app)
     : mApp (app)
     , mCache ("TransactionCache", 65536, 1800, stopwatch(),
         mApp.journal("TaggedCache"))
+    , mParsedCache ("STTxCache", 65536, 300, stopwatch(),
+        mApp.journal("TaggedCache"))
 {
 }
 
@@ -63,6 +67,31 @@ TransactionMaster::fetch (uint256 const& txnID, bool checkDisk)
     return txn;
 }
 
+std::shared_ptr<STTx const>
+TransactionMaster::parse (uint256 const& txnID, Slice const& data)
+{
+    auto txn = mParsedCache.fetch (txnID);
+
+    if (txn)
+        return txn;
+
+    SerialIter sit (data);
+    txn = std::make_shared<STTx const> (std::ref (sit));
+
+    // Data which is not canonically serialized hashes to
+    // something other than the ID of the parsed transaction.
+    if (txn->getTransactionID () == txnID)
+        mParsedCache.canonicalize (txnID, txn);
+
+    return txn;
+}
+
+std::shared_ptr<STTx const>
+TransactionMaster::parse (Slice const& data)
+{
+    return parse (sha512Half (HashPrefix::transactionID, data), data);
+}
+
 std::shared_ptr<STTx const>
 TransactionMaster::fetch (std::shared_ptr<SHAMapItem> const& item,
     SHAMapTreeNode::TNType type,
@@ -76,13 +105,12 @@ TransactionMaster::fetch (std::shared_ptr<SHAMapItem> const& item,
 
         if (type == SHAMapTreeNode::tnTRANSACTION_NM)
         {
-            SerialIter sit (item->slice());
-            txn = std::make_shared<STTx const> (std::ref (sit));
+            txn = parse (item->key(), item->slice());
         }
         else if (type == SHAMapTreeNode::tnTRANSACTION_MD)
         {
             auto blob = SerialIter{item->data(), item->size()}.getVL();
-            txn = std::make_shared<STTx const>(SerialIter{blob.data(), blob.size()});
+            txn = parse (item->key(), makeSlice(blob));
         }
     }
     else
@@ -106,12 +134,16 @@ TransactionMaster::canonicalize(std::shared_ptr<Transaction>* pTransaction)
         // VFALCO NOTE canonicalize can change the value of txn!
         mCache.canonicalize(tid, txn);
         *pTransaction = txn;
+
+        auto stx = txn->getSTransaction();
+        mParsedCache.canonicalize(tid, stx);
     }
 }
 
 void TransactionMaster::sweep (void)
 {
     mCache.sweep ();
+    mParsedCache.sweep ();
 }
 
 TaggedCache <uint256, Transaction>& TransactionMaster::getCache()
@@ -119,4 +151,9 @@ TaggedCache <uint256, Transaction>& TransactionMaster::getCache()
     return mCache;
 }
 
+TaggedCache <uint256, STTx const>& TransactionMaster::getParsedCache()
+{
+    return mParsedCache;
+}
+
 } // ripple
@@ -21,6 +21,7 @@
 #include <ripple/basics/Log.h>
 #include <ripple/protocol/digest.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/app/ledger/ReplayBenchmark.h>
 #include <ripple/basics/CheckLibraryVersions.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/StringUtilities.h>
@@ -37,13 +38,16 @@
 #include <ripple/server/Role.h>
 #include <ripple/protocol/BuildInfo.h>
 #include <ripple/beast/clock/basic_seconds_clock.h>
+#include <ripple/beast/core/LexicalCast.h>
 #include <ripple/beast/core/Time.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/utility/Debug.h>
 #include <beast/detail/stream/debug_ostream.hpp>
 #include <google/protobuf/stubs/common.h>
+#include <boost/optional.hpp>
 #include <boost/program_options.hpp>
 #include <cstdlib>
+#include <thread>
 #include <utility>
 
 #if defined(BEAST_LINUX) || defined(BEAST_MAC) || defined(BEAST_BSD)
@@ -247,6 +251,7 @@ int run (int argc, char** argv)
     ("load", "Load the current ledger from the local DB.")
     ("valid", "Consider the initial ledger a valid network ledger.")
     ("replay","Replay a ledger close.")
+    ("replay_range", po::value<std::string> (), "Rebuild the stored ledgers <first>-<last> and report engine timing.")
     ("ledger", po::value<std::string> (), "Load the specified ledger and start from .")
     ("ledgerfile", po::value<std::string> (), "Load the specified ledger file.")
     ("start", "Start from a fresh Ledger.")
@@ -358,6 +363,31 @@ int run (int argc, char** argv)
         config->START_VALID = true;
     }
 
+    boost::optional<std::pair<std::uint32_t, std::uint32_t>> replayRange;
+    if (vm.count ("replay_range"))
+    {
+        auto const range = vm["replay_range"].as<std::string> ();
+        auto const dash = range.find ('-');
+        std::uint32_t first = 0;
+        std::uint32_t last = 0;
+
+        if (dash == std::string::npos ||
+            ! beast::lexicalCastChecked (first, range.substr (0, dash)) ||
+            ! beast::lexicalCastChecked (last, range.substr (dash + 1)) ||
+            first < 2 || last < first)
+        {
+            std::cerr << "Invalid replay_range = " << range << std::endl;
+            return -1;
+        }
+
+        // Start from the ledger preceding the range, without peers
+        config->RUN_STANDALONE = true;
+        config->LEDGER_HISTORY = 0;
+        config->START_LEDGER = std::to_string (first - 1);
+        config->START_UP = Config::LOAD;
+        replayRange.emplace (first, last);
+    }
+
     if (vm.count ("net"))
     {
         if ((config->START_UP == Config::LOAD) ||
@@ -477,6 +507,24 @@ int run (int argc, char** argv)
             return -1;
         }
 
+        if (replayRange)
+        {
+            app->doStart ();
+            std::thread thread ([&app]{ app->run (); });
+
+            auto const report = replayLedgerRange (*app,
+                replayRange->first, replayRange->second,
+                    app->journal ("ReplayBenchmark"));
+            std::cout << Json::pretty (report) << std::endl;
+
+            app->signalStop ();
+            thread.join ();
+
+            if (report.isMember ("error") || report["mismatched"].size ())
+                return -1;
+            return 0;
+        }
+
         startServer (*app);
         return 0;
     }
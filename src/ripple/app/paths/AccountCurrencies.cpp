@@ -27,36 +27,12 @@ hash_set<Currency> accountSourceCurrencies (
     std::shared_ptr<RippleLineCache> const& lrCache,
     bool includeXRP)
 {
-    hash_set<Currency> currencies;
+    auto currencies = lrCache->getCurrencies (account).source;
 
     // YYY Only bother if they are above reserve
     if (includeXRP)
         currencies.insert (xrpCurrency());
 
-    // List of ripple lines.
-    auto& rippleLines = lrCache->getRippleLines (account);
-
-    for (auto const& item : rippleLines)
-    {
-        auto rspEntry = (RippleState*) item.get ();
-        assert (rspEntry);
-        if (!rspEntry)
-            continue;
-
-        auto& saBalance = rspEntry->getBalance ();
-
-        // Filter out non
-        if (saBalance > zero
-            // Have IOUs to send.
-            || (rspEntry->getLimitPeer ()
-                // Peer extends credit.
-                && ((-saBalance) < rspEntry->getLimitPeer ()))) // Credit left.
-        {
-            currencies.insert (saBalance.getCurrency ());
-        }
-    }
-
-    currencies.erase (badCurrency());
     return currencies;
 }
 
@@ -65,29 +41,12 @@ hash_set<Currency> accountDestCurrencies (
     std::shared_ptr<RippleLineCache> const& lrCache,
     bool includeXRP)
 {
-    hash_set<Currency> currencies;
+    auto currencies = lrCache->getCurrencies (account).destination;
 
+    // Even if account doesn't exist
     if (includeXRP)
         currencies.insert (xrpCurrency());
-    // Even if account doesn't exist
-
-    // List of ripple lines.
-    auto& rippleLines = lrCache->getRippleLines (account);
-
-    for (auto const& item : rippleLines)
-    {
-        auto rspEntry = (RippleState*) item.get ();
-        assert (rspEntry);
-        if (!rspEntry)
-            continue;
-
-        auto& saBalance  = rspEntry->getBalance ();
-
-        if (saBalance < rspEntry->getLimit ())                  // Can take more
-            currencies.insert (saBalance.getCurrency ());
-    }
 
-    currencies.erase (badCurrency());
     return currencies;
 }
 
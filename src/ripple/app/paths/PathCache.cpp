@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/app/paths/PathCache.h>
+#include <algorithm>
+
+namespace ripple {
+
+int
+PathCache::amountBucket (STAmount const& amount)
+{
+    // IOU mantissas are normalized, so the exponent alone
+    // gives the magnitude.
+    if (! amount.native ())
+        return amount.exponent ();
+
+    int bucket = 0;
+    for (auto m = amount.mantissa (); m >= 10; m /= 10)
+        ++bucket;
+    return bucket;
+}
+
+bool
+PathCache::find (ReadView const& ledger, Key const& key, STPathSet& paths)
+{
+    // Open ledgers and ledgers older than the one cached are
+    // never served, so looking there is not counted as a miss.
+    if (ledger.open ())
+        return false;
+
+    std::lock_guard<std::mutex> sl (mutex_);
+
+    if (ledger.info ().seq < seq_)
+        return false;
+
+    if (ledger.info ().hash != hash_)
+    {
+        ++misses_;
+        return false;
+    }
+
+    auto const it = paths_.find (key);
+    if (it == paths_.end ())
+    {
+        ++misses_;
+        return false;
+    }
+
+    ++hits_;
+    paths = it->second;
+    return true;
+}
+
+void
+PathCache::insert (ReadView const& ledger, Key const& key,
+    STPathSet const& paths)
+{
+    if (ledger.open ())
+        return;
+
+    auto const& info = ledger.info ();
+
+    std::lock_guard<std::mutex> sl (mutex_);
+
+    if (info.hash != hash_)
+    {
+        // Don't let a request on an older ledger
+        // throw away the paths of a newer one
+        if (info.seq < seq_)
+            return;
+
+        paths_.clear ();
+        seq_ = info.seq;
+        hash_ = info.hash;
+    }
+
+    if (paths_.size () < maxEntries)
+        paths_.emplace (key, paths);
+}
+
+float
+PathCache::getHitRate () const
+{
+    std::lock_guard<std::mutex> sl (mutex_);
+    auto const total = static_cast<float> (hits_ + misses_);
+    return hits_ * (100.0f / std::max (1.0f, total));
+}
+
+} // ripple
@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_APP_PATHS_PATHCACHE_H_INCLUDED
+#define RIPPLE_APP_PATHS_PATHCACHE_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/beast/hash/hash_append.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/Issue.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/STPathSet.h>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace ripple {
+
+/** Candidate paths found on a closed ledger.
+
+    Requests for the same source, destination and currencies with
+    amounts of a similar size find the same candidate paths, so
+    the search is done once per ledger. Liquidity is not cached:
+    the caller still ranks the candidates for its own amount.
+
+    Only one ledger is cached at a time. Entries for an older
+    ledger are dropped when paths for a newer one are inserted.
+*/
+class PathCache
+{
+public:
+    struct Key
+    {
+        AccountID srcAccount;
+        AccountID dstAccount;
+        Currency srcCurrency;
+        AccountID srcIssuer;
+        bool hasSrcIssuer;
+        Issue dstIssue;
+        int amountBucket;
+        int searchLevel;
+
+        bool
+        operator== (Key const& other) const
+        {
+            return srcAccount == other.srcAccount &&
+                dstAccount == other.dstAccount &&
+                srcCurrency == other.srcCurrency &&
+                srcIssuer == other.srcIssuer &&
+                hasSrcIssuer == other.hasSrcIssuer &&
+                dstIssue == other.dstIssue &&
+                amountBucket == other.amountBucket &&
+                searchLevel == other.searchLevel;
+        }
+
+        template <class Hasher>
+        friend
+        void
+        hash_append (Hasher& h, Key const& k)
+        {
+            using beast::hash_append;
+            hash_append (h, k.srcAccount, k.dstAccount, k.srcCurrency,
+                k.srcIssuer, k.hasSrcIssuer, k.dstIssue,
+                    k.amountBucket, k.searchLevel);
+        }
+    };
+
+    /** Returns the order of magnitude of an amount. */
+    static
+    int
+    amountBucket (STAmount const& amount);
+
+    /** Find the candidate paths for a request.
+        @return `true` if paths were found for this ledger.
+    */
+    bool
+    find (ReadView const& ledger, Key const& key, STPathSet& paths);
+
+    /** Remember the candidate paths for a request. */
+    void
+    insert (ReadView const& ledger, Key const& key, STPathSet const& paths);
+
+    /** Returns the percentage of lookups that found paths.
+        Lookups on ledgers the cache never holds are not counted.
+    */
+    float
+    getHitRate () const;
+
+private:
+    // Bound on the requests remembered for one ledger
+    static std::size_t const maxEntries = 4096;
+
+    std::mutex mutable mutex_;
+    LedgerIndex seq_ = 0;
+    uint256 hash_;
+    hash_map<Key, STPathSet> paths_;
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+
+} // ripple
+
+#endif
@@ -50,6 +50,7 @@ PathRequest::PathRequest (
         , wpSubscriber (subscriber)
         , consumer_(subscriber->getConsumer())
         , jvStatus (Json::objectValue)
+        , rankJobs_ (Pathfinder::maxJobs (app.config()))
         , mLastIndex (0)
         , mInProgress (false)
         , iLastLevel (0)
@@ -74,6 +75,7 @@ PathRequest::PathRequest (
         , fCompletion (completion)
         , consumer_ (consumer)
         , jvStatus (Json::objectValue)
+        , rankJobs_ (Pathfinder::maxJobs (app.config()))
         , mLastIndex (0)
         , mInProgress (false)
         , iLastLevel (0)
@@ -455,11 +457,26 @@ Json::Value PathRequest::doStatus (Json::Value const&)
     return jvStatus;
 }
 
+// Shares the time left before the deadline equally
+// among the searches still to run.
+static
+Pathfinder::clock_type::time_point
+timeSlice (Pathfinder::clock_type::time_point deadline, std::size_t searches)
+{
+    using clock_type = Pathfinder::clock_type;
+    if (deadline == clock_type::time_point::max() || searches <= 1)
+        return deadline;
+    auto const now = clock_type::now();
+    if (now >= deadline)
+        return deadline;
+    return now + (deadline - now) / searches;
+}
+
 std::unique_ptr<Pathfinder> const&
 PathRequest::getPathFinder(std::shared_ptr<RippleLineCache> const& cache,
     hash_map<Currency, std::unique_ptr<Pathfinder>>& currency_map,
         Currency const& currency, STAmount const& dst_amount,
-            int const level)
+            int const level, Pathfinder::clock_type::time_point deadline)
 {
     auto i = currency_map.find(currency);
     if (i != currency_map.end())
@@ -467,6 +484,8 @@ PathRequest::getPathFinder(std::shared_ptr<RippleLineCache> const& cache,
     auto pathfinder = std::make_unique<Pathfinder>(
         cache, *raSrcAccount, *raDstAccount, currency,
             boost::none, dst_amount, saSendMax, app_);
+    pathfinder->setRankJobs(rankJobs_);
+    pathfinder->setDeadline(deadline);
     if (pathfinder->findPaths(level))
         pathfinder->computePathRanks(max_paths_);
     else
@@ -476,7 +495,8 @@ PathRequest::getPathFinder(std::shared_ptr<RippleLineCache> const& cache,
 
 bool
 PathRequest::findPaths (std::shared_ptr<RippleLineCache> const& cache,
-    int const level, Json::Value& jvArray)
+    int const level, Json::Value& jvArray,
+        std::function <void (Json::Value const&)> const& interim)
 {
     auto sourceCurrencies = sciSourceCurrencies;
     if (sourceCurrencies.empty ())
@@ -498,7 +518,60 @@ PathRequest::findPaths (std::shared_ptr<RippleLineCache> const& cache,
     auto const dst_amount = convert_all_ ?
         STAmount(saDstAmount.issue(), STAmount::cMaxValue, STAmount::cMaxOffset)
             : saDstAmount;
+
+    // The search stops when the time runs out, keeping what it found.
+    // Each source currency gets its share of the time, and at least
+    // a fast search.
+    using clock_type = Pathfinder::clock_type;
+    auto const deadline = app_.config().PATH_SEARCH_TIME > 0
+        ? clock_type::now() +
+            std::chrono::milliseconds(app_.config().PATH_SEARCH_TIME)
+        : clock_type::time_point::max();
+
     hash_map<Currency, std::unique_ptr<Pathfinder>> currency_map;
+    int const fastLevel = app_.config().PATH_SEARCH_FAST;
+    if (interim && level > fastLevel)
+    {
+        // Report the cheap paths, then deepen the same searches
+        Json::Value jvFast (Json::arrayValue);
+        findAlternatives(cache, sourceCurrencies, dst_amount,
+            fastLevel, deadline, currency_map, jvFast);
+        if (jvFast.size())
+            interim(jvFast);
+
+        auto remaining = currency_map.size();
+        for (auto& entry : currency_map)
+        {
+            auto& pathfinder = entry.second;
+            auto const slice = timeSlice(deadline, remaining--);
+            if (! pathfinder || pathfinder->timedOut())
+                continue;
+            pathfinder->setDeadline(slice);
+            if (pathfinder->findPaths(level))
+                pathfinder->computePathRanks(max_paths_);
+        }
+    }
+    findAlternatives(cache, sourceCurrencies, dst_amount,
+        level, deadline, currency_map, jvArray);
+
+    /*  The resource fee is based on the number of source currencies used.
+        The minimum cost is 50 and the maximum is 400. The cost increases
+        after four source currencies, 50 - (4 * 4) = 34.
+    */
+    int const size = sourceCurrencies.size();
+    consumer_.charge({boost::algorithm::clamp(size * size + 34, 50, 400),
+        "path update"});
+    return true;
+}
+
+void
+PathRequest::findAlternatives (std::shared_ptr<RippleLineCache> const& cache,
+    std::set<Issue> const& sourceCurrencies, STAmount const& dst_amount,
+        int const level, Pathfinder::clock_type::time_point deadline,
+            hash_map<Currency, std::unique_ptr<Pathfinder>>& currency_map,
+                Json::Value& jvArray)
+{
+    auto remaining = sourceCurrencies.size();
     for (auto const& issue : sourceCurrencies)
     {
         JLOG(m_journal.debug())
@@ -507,7 +580,8 @@ PathRequest::findPaths (std::shared_ptr<RippleLineCache> const& cache,
             << STAmount(issue, 1).getFullText();
 
         auto& pathfinder = getPathFinder(cache, currency_map,
-            issue.currency, dst_amount, level);
+            issue.currency, dst_amount, level,
+                timeSlice(deadline, remaining--));
         if (! pathfinder)
         {
             assert(false);
@@ -607,15 +681,6 @@ PathRequest::findPaths (std::shared_ptr<RippleLineCache> const& cache,
                 << transHuman(rc.result());
         }
     }
-
-    /*  The resource fee is based on the number of source currencies used.
-        The minimum cost is 50 and the maximum is 400. The cost increases
-        after four source currencies, 50 - (4 * 4) = 34.
-    */
-    int const size = sourceCurrencies.size();
-    consumer_.charge({boost::algorithm::clamp(size * size + 34, 50, 400),
-        "path update"});
-    return true;
 }
 
 Json::Value PathRequest::doUpdate(
@@ -688,8 +753,28 @@ Json::Value PathRequest::doUpdate(
     JLOG(m_journal.debug()) << iIdentifier
         << " processing at level " << iLevel;
 
+    // Until its first full reply, a path_find subscriber is sent the
+    // alternatives a fast search finds without waiting for the full
+    // search. Later updates already have a full reply to go on.
+    std::function <void (Json::Value const&)> interim;
+    if (! fast && ! hasCompletion () &&
+        full_reply_ == steady_clock::time_point{})
+    {
+        if (auto sub = getSubscriber ())
+        {
+            interim = [&newStatus, sub](Json::Value const& alternatives)
+            {
+                Json::Value status = newStatus;
+                status[jss::alternatives] = alternatives;
+                status[jss::full_reply] = false;
+                status[jss::type] = "path_find";
+                sub->send (status, false);
+            };
+        }
+    }
+
     Json::Value& jvArray = (newStatus[jss::alternatives] = Json::arrayValue);
-    if (! findPaths(cache, iLevel, jvArray))
+    if (! findPaths(cache, iLevel, jvArray, interim))
         newStatus = rpcError(rpcINTERNAL);
 
     bLastSuccess = jvArray.size();
@@ -93,6 +93,12 @@ public:
     InfoSub::pointer getSubscriber ();
     bool hasCompletion ();
 
+    // Set the number of jobs each search may rank paths with
+    void setRankJobs (std::size_t jobs)
+    {
+        rankJobs_ = jobs;
+    }
+
 private:
     using ScopedLockType = std::lock_guard <std::recursive_mutex>;
 
@@ -102,13 +108,22 @@ private:
     std::unique_ptr<Pathfinder> const&
     getPathFinder(std::shared_ptr<RippleLineCache> const&,
         hash_map<Currency, std::unique_ptr<Pathfinder>>&, Currency const&,
-            STAmount const&, int const);
+            STAmount const&, int const, Pathfinder::clock_type::time_point);
 
     /** Finds and sets a PathSet in the JSON argument.
         Returns false if the source currencies are inavlid.
+        If interim is set, it is first passed what a fast search finds.
     */
     bool
-    findPaths (std::shared_ptr<RippleLineCache> const&, int const, Json::Value&);
+    findPaths (std::shared_ptr<RippleLineCache> const&, int const, Json::Value&,
+        std::function <void (Json::Value const&)> const& interim);
+
+    // Appends the alternative found for each source currency.
+    void
+    findAlternatives (std::shared_ptr<RippleLineCache> const&,
+        std::set<Issue> const&, STAmount const&, int const,
+            Pathfinder::clock_type::time_point,
+                hash_map<Currency, std::unique_ptr<Pathfinder>>&, Json::Value&);
 
     int parseJson (Json::Value const&);
 
@@ -136,6 +151,7 @@ private:
     std::map<Issue, STPathSet> mContext;
 
     bool convert_all_;
+    std::size_t rankJobs_;
 
     std::recursive_mutex mIndexLock;
     LedgerIndex mLastIndex;
@@ -23,6 +23,7 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/basics/Log.h>
 #include <ripple/core/JobQueue.h>
+#include <ripple/core/ParallelFor.h>
 #include <ripple/protocol/JsonFields.h>
 #include <ripple/resource/Fees.h>
 #include <algorithm>
@@ -37,21 +38,126 @@ PathRequests::getLineCache (
     std::shared_ptr <ReadView const> const& ledger,
     bool authoritative)
 {
-    ScopedLockType sl (mLock);
+    auto const stale = [&]
+    {
+        std::uint32_t lineSeq = mLineCache ? mLineCache->getLedger()->seq() : 0;
+        std::uint32_t lgrSeq = ledger->seq();
 
-    std::uint32_t lineSeq = mLineCache ? mLineCache->getLedger()->seq() : 0;
-    std::uint32_t lgrSeq = ledger->seq();
+        return (lineSeq == 0) ||                                 // no ledger
+            (authoritative && (lgrSeq > lineSeq)) ||          // newer authoritative ledger
+            (authoritative && ((lgrSeq + 8)  < lineSeq)) ||   // we jumped way back for some reason
+            (lgrSeq > (lineSeq + 8));                         // we jumped way forward for some reason
+    };
 
-    if ( (lineSeq == 0) ||                                 // no ledger
-         (authoritative && (lgrSeq > lineSeq)) ||          // newer authoritative ledger
-         (authoritative && ((lgrSeq + 8)  < lineSeq)) ||   // we jumped way back for some reason
-         (lgrSeq > (lineSeq + 8)))                         // we jumped way forward for some reason
     {
-        mLineCache = std::make_shared<RippleLineCache> (ledger);
+        ScopedLockType sl (mLock);
+        if (!stale ())
+            return mLineCache;
     }
+
+    // Moving the graph may load the ledgers skipped since the last
+    // one, so it is done without our lock. The graph has its own.
+    if (authoritative && !ledger->open())
+        advanceGraph (ledger);
+    auto cache = std::make_shared<RippleLineCache> (ledger, mGraph);
+
+    ScopedLockType sl (mLock);
+    if (stale ())
+        mLineCache = std::move (cache);
     return mLineCache;
 }
 
+/** Move the trust line graph to a new authoritative ledger.
+    Ledgers skipped since the last one are applied first, when
+    we have them, so the graph can be patched rather than
+    started over. Called without mLock held.
+*/
+void
+PathRequests::advanceGraph (std::shared_ptr <ReadView const> const& ledger)
+{
+    auto const seq = ledger->seq();
+    auto const graphSeq = mGraph->seq();
+
+    if (graphSeq != 0 && graphSeq < seq && (graphSeq + 8) >= seq)
+    {
+        for (auto s = graphSeq + 1; s < seq; ++s)
+        {
+            auto const skipped = app_.getLedgerMaster().getLedgerBySeq (s);
+            if (!skipped)
+                break;
+            mGraph->advance (*skipped);
+        }
+    }
+
+    mGraph->advance (*ledger);
+}
+
+// The requests of one updateAll pass, shared by the jobs
+// that work through them.
+struct PathRequests::UpdatePass
+{
+    std::shared_ptr<RippleLineCache> cache;
+    bool newRequests;
+
+    // Entries are null where the request has gone away
+    std::vector<PathRequest::pointer> requests;
+
+    // Written only by the job that updates the entry
+    std::vector<char> remove;
+
+    std::atomic<std::size_t> claimed {0};
+    std::atomic<int> processed {0};
+    std::atomic<bool> mustBreak {false};
+};
+
+void PathRequests::updateRequest (UpdatePass& pass, std::size_t i)
+{
+    using namespace std::chrono;
+
+    auto const& request = pass.requests[i];
+    auto const& cache = pass.cache;
+
+    if (!request)
+    {
+        pass.remove[i] = true;
+        return;
+    }
+
+    if (!request->needsUpdate (pass.newRequests, cache->getLedger()->seq()))
+        return;
+
+    auto const start = steady_clock::now();
+
+    if (auto ipSub = request->getSubscriber ())
+    {
+        if (ipSub->getConsumer ().warn ())
+        {
+            pass.remove[i] = true;
+            return;
+        }
+
+        Json::Value update = request->doUpdate (cache, false);
+        request->updateComplete ();
+        update[jss::type] = "path_find";
+        ipSub->send (update, false);
+    }
+    else if (request->hasCompletion ())
+    {
+        // One-shot request with completion function
+        request->doUpdate (cache, false);
+        request->updateComplete();
+    }
+    else
+    {
+        pass.remove[i] = true;
+        return;
+    }
+
+    ++pass.processed;
+    mUpdate.notify (duration_cast<milliseconds>(
+        steady_clock::now() - start));
+}
+
 void PathRequests::updateAll (std::shared_ptr <ReadView const> const& inLedger,
                               Job::CancelCallback shouldCancel)
 {
@@ -66,88 +172,98 @@ void PathRequests::updateAll (std::shared_ptr <ReadView const> const& inLedger,
     {
         ScopedLockType sl (mLock);
         requests = requests_;
-        cache = getLineCache (inLedger, true);
     }
+    cache = getLineCache (inLedger, true);
+
+    if (requests.empty())
+        return;
 
     bool newRequests = app_.getLedgerMaster().isNewPathRequest();
-    bool mustBreak = false;
 
     JLOG (mJournal.trace()) <<
         "updateAll seq=" << cache->getLedger()->seq() <<
         ", " << requests.size() << " requests";
 
+    // Each update builds its own Pathfinder, so besides the line
+    // cache, which is safe to share, updates are independent and
+    // we spread them over a few jobs. The jobs left over are given
+    // to the ranking within each update.
+    auto const maxJobs = Pathfinder::maxJobs (app_.config());
+
     int processed = 0, removed = 0;
+    std::size_t skipped = 0;
 
     do
     {
+        UpdatePass pass;
+        pass.cache = cache;
+        pass.newRequests = newRequests;
+        pass.requests.reserve (requests.size());
         for (auto const& wr : requests)
-        {
-            if (shouldCancel())
-                break;
+            pass.requests.push_back (wr.lock());
+        pass.remove.resize (requests.size(), false);
 
-            auto request = wr.lock ();
-            bool remove = true;
+        auto const n = pass.requests.size();
+        auto const rankJobs = std::max<std::size_t> (
+            1, maxJobs / std::min (maxJobs, n));
 
-            if (request)
+        parallelFor (app_.getJobQueue(), jtUPDATE_PF, "PathRequest::update",
+            n, maxJobs,
+            [&](std::size_t i)
             {
-                if (!request->needsUpdate (newRequests, cache->getLedger()->seq()))
-                    remove = false;
-                else
+                if (pass.mustBreak || shouldCancel())
                 {
-                    if (auto ipSub = request->getSubscriber ())
-                    {
-                        if (!ipSub->getConsumer ().warn ())
-                        {
-                            Json::Value update = request->doUpdate (cache, false);
-                            request->updateComplete ();
-                            update[jss::type] = "path_find";
-                            ipSub->send (update, false);
-                            remove = false;
-                            ++processed;
-                        }
-                    }
-                    else if (request->hasCompletion ())
-                    {
-                        // One-shot request with completion function
-                        request->doUpdate (cache, false);
-                        request->updateComplete();
-                        ++processed;
-                    }
+                    pass.mustBreak = true;
+                    return;
                 }
-            }
 
-            if (remove)
-            {
-                ScopedLockType sl (mLock);
-
-                // Remove any dangling weak pointers or weak
-                // pointers that refer to this path request.
-                auto ret = std::remove_if (
-                    requests_.begin(), requests_.end(),
-                    [&removed,&request](auto const& wl)
-                    {
-                        auto r = wl.lock();
-
-                        if (r && r != request)
-                            return false;
-                        ++removed;
-                        return true;
-                    });
-
-                requests_.erase (ret, requests_.end());
-            }
-
-            mustBreak = !newRequests &&
-                app_.getLedgerMaster().isNewPathRequest();
-
-            // We weren't handling new requests and then
-            // there was a new request
-            if (mustBreak)
-                break;
+                ++pass.claimed;
+                if (pass.requests[i])
+                    pass.requests[i]->setRankJobs (rankJobs);
+                updateRequest (pass, i);
+
+                // We weren't handling new requests and then
+                // there was a new request
+                if (!pass.newRequests &&
+                    app_.getLedgerMaster().isNewPathRequest())
+                {
+                    pass.mustBreak = true;
+                }
+            });
+
+        processed += pass.processed;
+        skipped += n - pass.claimed;
+
+        std::vector<PathRequest*> finished;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (pass.remove[i] && pass.requests[i])
+                finished.push_back (pass.requests[i].get());
+        }
+        std::sort (finished.begin(), finished.end());
+
+        {
+            ScopedLockType sl (mLock);
 
+            // Remove any dangling weak pointers or weak
+            // pointers that refer to finished path requests.
+            auto ret = std::remove_if (
+                requests_.begin(), requests_.end(),
+                [&removed,&finished](auto const& wl)
+                {
+                    auto r = wl.lock();
+
+                    if (r && !std::binary_search (
+                            finished.begin(), finished.end(), r.get()))
+                        return false;
+                    ++removed;
+                    return true;
+                });
+
+            requests_.erase (ret, requests_.end());
         }
 
-        if (mustBreak)
+        if (pass.mustBreak)
         { // a new request came in while we were working
             newRequests = true;
         }
@@ -169,14 +285,17 @@ void PathRequests::updateAll (std::shared_ptr <ReadView const> const& inLedger,
             if (requests_.empty())
                 break;
             requests = requests_;
-            cache = getLineCache (cache->getLedger(), false);
         }
+        cache = getLineCache (cache->getLedger(), false);
     }
     while (!shouldCancel ());
 
+    if (skipped != 0)
+        mSkipped += skipped;
+
     JLOG (mJournal.debug()) <<
-        "updateAll complete: " << processed << " processed and " <<
-        removed << " removed";
+        "updateAll complete: " << processed << " processed, " <<
+        removed << " removed and " << skipped << " skipped";
 }
 
 void PathRequests::insertPathRequest (
@@ -21,8 +21,10 @@
 #define RIPPLE_APP_PATHS_PATHREQUESTS_H_INCLUDED
 
 #include <ripple/app/main/Application.h>
+#include <ripple/app/paths/PathCache.h>
 #include <ripple/app/paths/PathRequest.h>
 #include <ripple/app/paths/RippleLineCache.h>
+#include <ripple/app/paths/TrustLineGraph.h>
 #include <ripple/core/Job.h>
 #include <atomic>
 #include <mutex>
@@ -37,10 +39,13 @@ public:
             beast::Journal journal, beast::insight::Collector::ptr const& collector)
         : app_ (app)
         , mJournal (journal)
+        , mGraph (std::make_shared<TrustLineGraph> (journal))
         , mLastIdentifier (0)
     {
         mFast = collector->make_event ("pathfind_fast");
         mFull = collector->make_event ("pathfind_full");
+        mUpdate = collector->make_event ("pathfind_update");
+        mSkipped = collector->make_counter ("pathfind_skipped");
     }
 
     void updateAll (std::shared_ptr<ReadView const> const& ledger,
@@ -61,6 +66,16 @@ public:
         std::shared_ptr<ReadView const> const& inLedger,
         Json::Value const& request);
 
+    std::shared_ptr<TrustLineGraph> const& getTrustLineGraph () const
+    {
+        return mGraph;
+    }
+
+    PathCache& getPathCache ()
+    {
+        return mPathCache;
+    }
+
     void reportFast (std::chrono::milliseconds ms)
     {
         mFast.notify (ms);
@@ -72,20 +87,37 @@ public:
     }
 
 private:
+    struct UpdatePass;
+
     void insertPathRequest (PathRequest::pointer const&);
 
+    void advanceGraph (std::shared_ptr <ReadView const> const& ledger);
+
+    void updateRequest (UpdatePass& pass, std::size_t i);
+
     Application& app_;
     beast::Journal                   mJournal;
 
     beast::insight::Event            mFast;
     beast::insight::Event            mFull;
 
+    // Time taken by each update, and updates a pass
+    // gave up on because it was canceled or preempted
+    beast::insight::Event            mUpdate;
+    beast::insight::Counter          mSkipped;
+
     // Track all requests
     std::vector<PathRequest::wptr> requests_;
 
     // Use a RippleLineCache
     std::shared_ptr<RippleLineCache>         mLineCache;
 
+    // Trust lines carried from one ledger's cache to the next
+    std::shared_ptr<TrustLineGraph>          mGraph;
+
+    // Candidate paths of recent requests on the latest closed ledger
+    PathCache                        mPathCache;
+
     std::atomic<int>                 mLastIdentifier;
 
     using ScopedLockType = std::lock_guard <std::recursive_mutex>;
@@ -349,7 +349,7 @@ TER PathState::pushNode (
         }
 
         if (resultCode == tesSUCCESS)
-            nodes_.push_back (node);
+            nodes_.push_back (std::move (node));
     }
     else
     {
@@ -394,7 +394,7 @@ TER PathState::pushNode (
         }
 
         if (resultCode == tesSUCCESS)
-            nodes_.push_back (node);
+            nodes_.push_back (std::move (node));
     }
 
     JLOG (j_.trace()) << "pushNode< : " << transToken (resultCode);
@@ -438,6 +438,9 @@ TER PathState::expandPath (
 
     terStatus = tesSUCCESS;
 
+    // Each element may imply an offer and an issuer before it
+    nodes_.reserve (3 * (spSourcePath.size () + 2));
+
     // XRP with issuer is malformed.
     if ((isXRP (uMaxCurrencyID) && !isXRP (uMaxIssuerID))
         || (isXRP (currencyOutID) && !isXRP (issuerOutID)))
@@ -32,8 +32,6 @@ class PathState : public CountedObject <PathState>
 {
   public:
     using OfferIndexList = std::vector<uint256>;
-    using Ptr = std::shared_ptr<PathState>;
-    using List = std::vector<Ptr>;
 
     PathState (PaymentSandbox const& parent,
             STAmount const& saSend,
@@ -48,6 +46,10 @@ class PathState : public CountedObject <PathState>
         view_.emplace(&parent);
     }
 
+    PathState (PathState const&) = delete;
+    PathState (PathState&&) = default;
+    PathState& operator= (PathState const&) = delete;
+
     void reset(STAmount const& in, STAmount const& out);
 
     TER expandPath (
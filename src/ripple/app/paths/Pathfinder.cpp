@@ -20,6 +20,7 @@
 #include <BeastConfig.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/paths/Tuning.h>
+#include <ripple/app/paths/PathRequests.h>
 #include <ripple/app/paths/Pathfinder.h>
 #include <ripple/app/paths/RippleCalc.h>
 #include <ripple/app/paths/RippleLineCache.h>
@@ -29,6 +30,8 @@
 #include <ripple/json/to_string.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/core/Config.h>
+#include <ripple/core/ParallelFor.h>
+#include <thread>
 #include <tuple>
 
 /*
@@ -165,6 +168,10 @@ Pathfinder::Pathfinder (
             STAmount(mDstAmount.issue(), STAmount::cMaxValue, STAmount::cMaxOffset)),
         mLedger (cache->getLedger ()),
         mRLCache (cache),
+        rankJobs_ (maxJobs (app.config ())),
+        deadline_ (clock_type::time_point::max ()),
+        timedOut_ (false),
+        searchingFast_ (true),
         app_ (app),
         j_ (app.journal ("Pathfinder"))
 {
@@ -175,6 +182,26 @@ Pathfinder::~Pathfinder()
 {
 }
 
+std::size_t
+Pathfinder::maxJobs (Config const& config)
+{
+    if (config.PATH_SEARCH_JOBS > 0)
+        return config.PATH_SEARCH_JOBS;
+
+    static std::size_t const jobs = std::min<std::size_t> (
+        4, std::max (1u, std::thread::hardware_concurrency ()));
+    return jobs;
+}
+
+bool Pathfinder::expired ()
+{
+    if (searchingFast_)
+        return false;
+    if (! timedOut_ && clock_type::now () >= deadline_)
+        timedOut_ = true;
+    return timedOut_;
+}
+
 bool Pathfinder::findPaths (int searchLevel)
 {
     if (mDstAmount == zero)
@@ -303,12 +330,37 @@ bool Pathfinder::findPaths (int searchLevel)
         paymentType = pt_nonXRP_to_nonXRP;
     }
 
+    // Requests on a closed ledger often repeat. The candidates found
+    // for an earlier one are ranked again for this amount by
+    // computePathRanks, so only the search is skipped.
+    auto& pathCache = app_.getPathRequests ().getPathCache ();
+    PathCache::Key const cacheKey {
+        mSrcAccount, mDstAccount, mSrcCurrency,
+        mSrcIssuer.value_or (AccountID ()), static_cast<bool> (mSrcIssuer),
+        mDstAmount.issue (), PathCache::amountBucket (mDstAmount),
+        searchLevel };
+
+    if (pathCache.find (*mLedger, cacheKey, mCompletePaths))
+    {
+        JLOG (j_.debug())
+                << mCompletePaths.size () << " complete paths cached";
+        return true;
+    }
+
     // Now iterate over all paths for that paymentType.
     for (auto const& costedPath : mPathTable[paymentType])
     {
         // Only use paths with at most the current search level.
         if (costedPath.searchLevel <= searchLevel)
         {
+            // The table is in order of cost, so stopping here keeps
+            // the cheapest paths. The deadline never stops the path
+            // types a fast search would try.
+            searchingFast_ =
+                costedPath.searchLevel <= app_.config().PATH_SEARCH_FAST;
+            if (expired ())
+                break;
+
             addPathsForType (costedPath.type);
 
             // TODO(tom): we might be missing other good paths with this
@@ -319,7 +371,12 @@ bool Pathfinder::findPaths (int searchLevel)
     }
 
     JLOG (j_.debug())
-            << mCompletePaths.size () << " complete paths found";
+            << mCompletePaths.size () << " complete paths found"
+            << (timedOut_ ? " before the deadline" : "");
+
+    // A search cut short would hide the paths it did not reach
+    if (! timedOut_)
+        pathCache.insert (*mLedger, cacheKey, mCompletePaths);
 
     // Even if we find no paths, default paths may work, and we don't check them
     // currently.
@@ -506,11 +563,19 @@ void Pathfinder::rankPaths (
         saMinDstAmount = smallestUsefulAmount(mDstAmount, maxPaths);
     }
 
-    for (int i = 0; i < paths.size (); ++i)
-    {
-        auto const& currentPath = paths[i];
-        if (! currentPath.empty())
+    // Each path is simulated in its own sandbox over the same ledger,
+    // so the paths can be evaluated at the same time. Results are
+    // kept by index and gathered in order, which makes the ranking
+    // the same as evaluating them one after another.
+    std::vector<boost::optional<PathRank>> ranks (paths.size ());
+    parallelFor (app_.getJobQueue (), jtUPDATE_PF, "Pathfinder::rankPaths",
+        paths.size (), rankJobs_,
+        [&](std::size_t i)
         {
+            auto const& currentPath = paths[i];
+            if (currentPath.empty())
+                return;
+
             STAmount liquidity;
             uint64_t uQuality;
             auto const resultCode = getPathLiquidity (
@@ -528,10 +593,15 @@ void Pathfinder::rankPaths (
                     "findPaths: quality: " << uQuality <<
                     ": " << currentPath.getJson (0);
 
-                rankedPaths.push_back ({uQuality,
-                    currentPath.size (), liquidity, i});
+                ranks[i] = PathRank {uQuality,
+                    currentPath.size (), liquidity, static_cast<int> (i)};
             }
-        }
+        });
+
+    for (auto& rank : ranks)
+    {
+        if (rank)
+            rankedPaths.push_back (std::move (*rank));
     }
 
     // Sort paths by:
@@ -772,7 +842,11 @@ void Pathfinder::addLinks (
         << "addLink< on " << currentPaths.size ()
         << " source(s), flags=" << addFlags;
     for (auto const& path: currentPaths)
+    {
+        if (expired ())
+            break;
         addLink (path, incompletePaths, addFlags);
+    }
 }
 
 STPathSet& Pathfinder::addPathsForType (PathType const& pathType)
@@ -25,6 +25,7 @@
 #include <ripple/core/LoadEvent.h>
 #include <ripple/protocol/STAmount.h>
 #include <ripple/protocol/STPathSet.h>
+#include <chrono>
 
 namespace ripple {
 
@@ -37,6 +38,8 @@ namespace ripple {
 class Pathfinder
 {
 public:
+    using clock_type = std::chrono::steady_clock;
+
     /** Construct a pathfinder without an issuer.*/
     Pathfinder (
         std::shared_ptr<RippleLineCache> const& cache,
@@ -51,11 +54,47 @@ public:
 
     static void initPathTable ();
 
+    /** Find candidate paths up to a search level.
+
+        Path types are tried cheapest first. A later call with a deeper
+        level extends the search, reusing the partial paths already built.
+    */
     bool findPaths (int searchLevel);
 
+    /** Stop searching for paths at the given time.
+
+        The paths found before the deadline are kept, and once it has
+        passed findPaths adds no more. Path types at or below the fast
+        search level are always searched, so a search out of time still
+        finds what a fast search would.
+    */
+    void setDeadline (clock_type::time_point deadline)
+    {
+        deadline_ = deadline;
+    }
+
+    /** Returns true if the deadline cut the search short. */
+    bool timedOut () const
+    {
+        return timedOut_;
+    }
+
     /** Compute the rankings of the paths. */
     void computePathRanks (int maxPaths);
 
+    /** Set the number of jobs that rank paths at the same time.
+        With 1, paths are ranked on the calling thread only.
+    */
+    void setRankJobs (std::size_t jobs)
+    {
+        rankJobs_ = jobs;
+    }
+
+    /** Returns the number of jobs path finding may use at the same time.
+        Updates that run side by side share this limit between them.
+    */
+    static std::size_t maxJobs (Config const& config);
+
     /* Get the best paths, up to maxPaths in number, from mCompletePaths.
 
        On return, if fullLiquidityPath is not empty, then it contains the best
@@ -127,6 +166,9 @@ private:
 
     bool issueMatchesOrigin (Issue const&);
 
+    // Returns true once the deadline has passed.
+    bool expired ();
+
     int getPathsOut (
         Currency const& currency,
         AccountID const& account,
@@ -183,6 +225,12 @@ private:
     std::shared_ptr <ReadView const> mLedger;
     LoadEvent::pointer m_loadEvent;
     std::shared_ptr<RippleLineCache> mRLCache;
+    std::size_t rankJobs_;
+    clock_type::time_point deadline_;
+    bool timedOut_;
+
+    // True while building path types at or below the fast search level
+    bool searchingFast_;
 
     STPathElement mSource;
     STPathSet mCompletePaths;
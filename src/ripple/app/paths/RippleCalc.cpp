@@ -177,48 +177,46 @@ RippleCalc::Output RippleCalc::rippleCalculate (
 
 bool RippleCalc::addPathState(STPath const& path, TER& resultCode)
 {
-    auto pathState = std::make_shared<PathState> (
+    // Room for every path was reserved up front, so building
+    // a state never moves the ones already built.
+    assert (pathStateList_.size () < pathStateList_.capacity ());
+    pathStateList_.emplace_back (
         view, saDstAmountReq_, saMaxAmountReq_, j_);
+    auto& pathState = pathStateList_.back ();
 
-    if (!pathState)
-    {
-        resultCode = temUNKNOWN;
-        return false;
-    }
-
-    pathState->expandPath (
+    pathState.expandPath (
         path,
         uDstAccountID_,
         uSrcAccountID_);
 
-    if (pathState->status() == tesSUCCESS)
-        pathState->checkNoRipple (uDstAccountID_, uSrcAccountID_);
+    if (pathState.status() == tesSUCCESS)
+        pathState.checkNoRipple (uDstAccountID_, uSrcAccountID_);
 
-    if (pathState->status() == tesSUCCESS)
-        pathState->checkFreeze ();
+    if (pathState.status() == tesSUCCESS)
+        pathState.checkFreeze ();
 
-    pathState->setIndex (pathStateList_.size ());
+    pathState.setIndex (pathStateList_.size () - 1);
 
     JLOG (j_.debug())
         << "rippleCalc: Build direct:"
-        << " status: " << transToken (pathState->status());
+        << " status: " << transToken (pathState.status());
+
+    auto const status = pathState.status ();
+
+    // Only usable paths keep their slot, the next path reuses it.
+    if (status != tesSUCCESS)
+        pathStateList_.pop_back ();
 
     // Return if malformed.
-    if (isTemMalformed (pathState->status()))
+    if (isTemMalformed (status))
     {
-        resultCode = pathState->status();
+        resultCode = status;
         return false;
     }
 
-    if (pathState->status () == tesSUCCESS)
-    {
-        resultCode = pathState->status();
-        pathStateList_.push_back (pathState);
-    }
-    else if (pathState->status () != terNO_LINE)
-    {
-        resultCode = pathState->status();
-    }
+    // A path without a line is skipped, other failures are kept
+    if (status != terNO_LINE)
+        resultCode = status;
 
     return true;
 }
@@ -237,6 +235,8 @@ TER RippleCalc::rippleCalculate ()
     TER resultCode = temUNCERTAIN;
     permanentlyUnfundedOffers_.clear ();
     mumSource_.clear ();
+    pathStateList_.clear ();
+    pathStateList_.reserve (spsPaths_.size () + 1);
 
     // YYY Might do basic checks on src and dst validity as per doPayment.
 
@@ -296,35 +296,35 @@ TER RippleCalc::rippleCalculate ()
         bool multiQuality = false;
 
         // Find the best path.
-        for (auto pathState : pathStateList_)
+        for (auto& pathState : pathStateList_)
         {
-            if (pathState->quality())
+            if (pathState.quality())
                 // Only do active paths.
             {
                 // If computing the only non-dry path, compute multi-quality.
                 multiQuality = ((pathStateList_.size () - iDry) == 1);
 
                 // Update to current amount processed.
-                pathState->reset (actualAmountIn_, actualAmountOut_);
+                pathState.reset (actualAmountIn_, actualAmountOut_);
 
                 // Error if done, output met.
-                PathCursor pc(*this, *pathState, multiQuality, j_);
+                PathCursor pc(*this, pathState, multiQuality, j_);
                 pc.nextIncrement ();
 
                 // Compute increment.
                 JLOG (j_.debug())
                     << "rippleCalc: AFTER:"
-                    << " mIndex=" << pathState->index()
-                    << " uQuality=" << pathState->quality()
-                    << " rate=" << amountFromRate (pathState->quality());
+                    << " mIndex=" << pathState.index()
+                    << " uQuality=" << pathState.quality()
+                    << " rate=" << amountFromRate (pathState.quality());
 
-                if (!pathState->quality())
+                if (!pathState.quality())
                 {
                     // Path was dry.
 
                     ++iDry;
                 }
-                else if (pathState->outPass() == zero)
+                else if (pathState.outPass() == zero)
                 {
                     // Path is not dry, but moved no funds
                     // This should never happen. Consider the path dry
@@ -334,49 +334,49 @@ TER RippleCalc::rippleCalculate ()
 
                     assert (false);
 
-                    pathState->setQuality (0);
+                    pathState.setQuality (0);
                     ++iDry;
                 }
                 else
                 {
-                    if (!pathState->inPass() || !pathState->outPass())
+                    if (!pathState.inPass() || !pathState.outPass())
                     {
                         JLOG (j_.debug())
                             << "rippleCalc: better:"
                             << " uQuality="
-                            << amountFromRate (pathState->quality())
-                            << " inPass()=" << pathState->inPass()
-                            << " saOutPass=" << pathState->outPass();
+                            << amountFromRate (pathState.quality())
+                            << " inPass()=" << pathState.inPass()
+                            << " saOutPass=" << pathState.outPass();
                     }
 
-                    assert (pathState->inPass() && pathState->outPass());
+                    assert (pathState.inPass() && pathState.outPass());
 
                     JLOG (j_.debug())
                         << "Old flow iter (iter, in, out): "
                         << iPass << " "
-                        << pathState->inPass() << " "
-                        << pathState->outPass();
+                        << pathState.inPass() << " "
+                        << pathState.outPass();
 
                     if ((!inputFlags.limitQuality ||
-                         pathState->quality() <= uQualityLimit)
+                         pathState.quality() <= uQualityLimit)
                         // Quality is not limited or increment has allowed
                         // quality.
                         && (iBest < 0
                             // Best is not yet set.
                             || PathState::lessPriority (
-                                *pathStateList_[iBest], *pathState)))
+                                pathStateList_[iBest], pathState)))
                         // Current is better than set.
                     {
                         JLOG (j_.debug())
                             << "rippleCalc: better:"
-                            << " mIndex=" << pathState->index()
-                            << " uQuality=" << pathState->quality()
+                            << " mIndex=" << pathState.index()
+                            << " uQuality=" << pathState.quality()
                             << " rate="
-                            << amountFromRate (pathState->quality())
-                            << " inPass()=" << pathState->inPass()
-                            << " saOutPass=" << pathState->outPass();
+                            << amountFromRate (pathState.quality())
+                            << " inPass()=" << pathState.inPass()
+                            << " saOutPass=" << pathState.outPass();
 
-                        iBest   = pathState->index ();
+                        iBest   = pathState.index ();
                     }
                 }
             }
@@ -391,50 +391,50 @@ TER RippleCalc::rippleCalculate ()
                 << " Pass: " << iPass
                 << " Dry: " << iDry
                 << " Paths: " << pathStateList_.size ();
-            for (auto pathState: pathStateList_)
+            for (auto const& pathState: pathStateList_)
             {
                 stream
                     << "rippleCalc: "
-                    << "Summary: " << pathState->index()
+                    << "Summary: " << pathState.index()
                     << " rate: "
-                    << amountFromRate (pathState->quality())
-                    << " quality:" << pathState->quality()
-                    << " best: " << (iBest == pathState->index ());
+                    << amountFromRate (pathState.quality())
+                    << " quality:" << pathState.quality()
+                    << " best: " << (iBest == pathState.index ());
             }
         }
 
         if (iBest >= 0)
         {
             // Apply best path.
-            auto pathState = pathStateList_[iBest];
+            auto& pathState = pathStateList_[iBest];
 
             JLOG (j_.debug())
                 << "rippleCalc: best:"
                 << " uQuality="
-                << amountFromRate (pathState->quality())
-                << " inPass()=" << pathState->inPass()
-                << " saOutPass=" << pathState->outPass()
+                << amountFromRate (pathState.quality())
+                << " inPass()=" << pathState.inPass()
+                << " saOutPass=" << pathState.outPass()
                 << " iBest=" << iBest;
 
             // Record best pass' offers that became unfunded for deletion on
             // success.
 
             unfundedOffersFromBestPaths.insert (
-                pathState->unfundedOffers().begin (),
-                pathState->unfundedOffers().end ());
+                pathState.unfundedOffers().begin (),
+                pathState.unfundedOffers().end ());
 
             // Apply best pass' view
-            pathState->view().apply(view);
+            pathState.view().apply(view);
 
-            actualAmountIn_ += pathState->inPass();
-            actualAmountOut_ += pathState->outPass();
+            actualAmountIn_ += pathState.inPass();
+            actualAmountOut_ += pathState.outPass();
 
             JLOG (j_.trace())
                     << "rippleCalc: best:"
                     << " uQuality="
-                    << amountFromRate (pathState->quality())
-                    << " inPass()=" << pathState->inPass()
-                    << " saOutPass=" << pathState->outPass()
+                    << amountFromRate (pathState.quality())
+                    << " inPass()=" << pathState.inPass()
+                    << " saOutPass=" << pathState.outPass()
                     << " actualIn=" << actualAmountIn_
                     << " actualOut=" << actualAmountOut_
                     << " iBest=" << iBest;
@@ -442,7 +442,7 @@ TER RippleCalc::rippleCalculate ()
             if (multiQuality)
             {
                 ++iDry;
-                pathState->setQuality(0);
+                pathState.setQuality(0);
             }
 
             if (actualAmountOut_ == saDstAmountReq_)
@@ -469,7 +469,7 @@ TER RippleCalc::rippleCalculate ()
                 //
                 // Merge best pass' umReverse.
                 mumSource_.insert (
-                    pathState->reverse().begin (), pathState->reverse().end ());
+                    pathState.reverse().begin (), pathState.reverse().end ());
 
                 if (iPass >= PAYMENT_MAX_LOOPS)
                 {
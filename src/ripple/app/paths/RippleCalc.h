@@ -165,7 +165,10 @@ private:
     // Expanded path with all the actual nodes in it.
     // A path starts with the source account, ends with the destination account
     // and goes through other acounts or order books.
-    PathState::List pathStateList_;
+    //
+    // The states of a payment are kept in one block, reserved
+    // for all of its paths, rather than allocated one by one.
+    std::vector<PathState> pathStateList_;
 
     Input inputFlags;
 };
@@ -24,7 +24,9 @@
 namespace ripple {
 
 RippleLineCache::RippleLineCache(
-    std::shared_ptr <ReadView const> const& ledger)
+    std::shared_ptr <ReadView const> const& ledger,
+    std::shared_ptr <TrustLineGraph> const& graph)
+    : graph_ (graph)
 {
     // We want the caching that OpenView provides
     // And we need to own a shared_ptr to the input view
@@ -32,21 +34,57 @@ RippleLineCache::RippleLineCache(
     mLedger = std::make_shared<OpenView>(&*ledger, ledger);
 }
 
-std::vector<RippleState::pointer> const&
+RippleLineCache::lines_type const&
 RippleLineCache::getRippleLines (AccountID const& accountID)
 {
     AccountKey key (accountID, hasher_ (accountID));
 
+    {
+        std::lock_guard <std::mutex> sl (mLock);
+
+        auto const it = lines_.find (key);
+        if (it != lines_.end())
+            return *it->second;
+    }
+
+    // Path requests share the cache, so read the lines without
+    // holding the lock. If another thread got there first, its
+    // copy is kept and ours is discarded.
+    std::shared_ptr <lines_type const> items;
+    if (graph_)
+        items = graph_->getLines (accountID, *mLedger);
+    if (! items)
+        items = std::make_shared <lines_type const> (
+            getRippleStateItems (accountID, *mLedger));
+
     std::lock_guard <std::mutex> sl (mLock);
+    return *lines_.emplace (key, std::move (items)).first->second;
+}
 
-    auto it = lines_.emplace (key,
-        std::vector<RippleState::pointer>());
+RippleLineCache::currencies_type const&
+RippleLineCache::getCurrencies (AccountID const& accountID)
+{
+    AccountKey key (accountID, hasher_ (accountID));
+
+    {
+        std::lock_guard <std::mutex> sl (mLock);
 
-    if (it.second)
-        it.first->second = getRippleStateItems (
-            accountID, *mLedger);
+        auto const it = currencies_.find (key);
+        if (it != currencies_.end())
+            return *it->second;
+    }
 
-    return it.first->second;
+    // The graph counts the currencies of accounts with many
+    // lines, for the others the lines are scanned once here.
+    std::shared_ptr <currencies_type const> currencies;
+    if (graph_)
+        currencies = graph_->getCurrencies (accountID, *mLedger);
+    if (! currencies)
+        currencies = std::make_shared <currencies_type const> (
+            TrustLineGraph::currencies (getRippleLines (accountID)));
+
+    std::lock_guard <std::mutex> sl (mLock);
+    return *currencies_.emplace (key, std::move (currencies)).first->second;
 }
 
 } // ripple
@@ -22,6 +22,7 @@
 
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/paths/RippleState.h>
+#include <ripple/app/paths/TrustLineGraph.h>
 #include <ripple/basics/hardened_hash.h>
 #include <cstddef>
 #include <memory>
@@ -34,9 +35,18 @@ namespace ripple {
 class RippleLineCache
 {
 public:
+    using lines_type = TrustLineGraph::lines_type;
+    using currencies_type = TrustLineGraph::Currencies;
+
+    /** Create a cache for a ledger.
+
+        If a graph is given, lines are taken from it whenever
+        it follows the same ledger.
+    */
     explicit
     RippleLineCache (
-        std::shared_ptr <ReadView const> const& l);
+        std::shared_ptr <ReadView const> const& l,
+        std::shared_ptr <TrustLineGraph> const& graph = {});
 
     std::shared_ptr <ReadView const> const&
     getLedger () const
@@ -44,14 +54,19 @@ public:
         return mLedger;
     }
 
-    std::vector<RippleState::pointer> const&
+    lines_type const&
     getRippleLines (AccountID const& accountID);
 
+    /** Returns the currencies an account can send and receive. */
+    currencies_type const&
+    getCurrencies (AccountID const& accountID);
+
 private:
     std::mutex mLock;
 
     ripple::hardened_hash<> hasher_;
     std::shared_ptr <ReadView const> mLedger;
+    std::shared_ptr <TrustLineGraph> graph_;
 
     struct AccountKey
     {
@@ -91,8 +106,13 @@ private:
 
     hash_map <
         AccountKey,
-        std::vector <RippleState::pointer>,
+        std::shared_ptr <lines_type const>,
         AccountKey::Hash> lines_;
+
+    hash_map <
+        AccountKey,
+        std::shared_ptr <currencies_type const>,
+        AccountKey::Hash> currencies_;
 };
 
 } // ripple
@@ -41,22 +41,20 @@ RippleState::makeItem (
 RippleState::RippleState (
     std::shared_ptr<SLE const>&& sle,
         AccountID const& viewAccount)
-    : mLedgerEntry (std::move(sle))
-    , mLowLimit (mLedgerEntry->getFieldAmount (sfLowLimit))
-    , mHighLimit (mLedgerEntry->getFieldAmount (sfHighLimit))
-    , mLowID (mLowLimit.getIssuer ())
-    , mHighID (mHighLimit.getIssuer ())
-    , mBalance (mLedgerEntry->getFieldAmount (sfBalance))
+    : mKey (sle->getIndex ())
+    , mLowLimit (sle->getFieldAmount (sfLowLimit))
+    , mHighLimit (sle->getFieldAmount (sfHighLimit))
+    , mBalance (sle->getFieldAmount (sfBalance))
 {
-    mFlags          = mLedgerEntry->getFieldU32 (sfFlags);
+    mFlags          = sle->getFieldU32 (sfFlags);
 
-    mLowQualityIn   = mLedgerEntry->getFieldU32 (sfLowQualityIn);
-    mLowQualityOut  = mLedgerEntry->getFieldU32 (sfLowQualityOut);
+    mLowQualityIn   = sle->getFieldU32 (sfLowQualityIn);
+    mLowQualityOut  = sle->getFieldU32 (sfLowQualityOut);
 
-    mHighQualityIn  = mLedgerEntry->getFieldU32 (sfHighQualityIn);
-    mHighQualityOut = mLedgerEntry->getFieldU32 (sfHighQualityOut);
+    mHighQualityIn  = sle->getFieldU32 (sfHighQualityIn);
+    mHighQualityOut = sle->getFieldU32 (sfHighQualityOut);
 
-    mViewLowest = (mLowID == viewAccount);
+    mViewLowest = (mLowLimit.getIssuer () == viewAccount);
 
     if (!mViewLowest)
         mBalance.negate ();
@@ -65,8 +63,8 @@ RippleState::RippleState (
 Json::Value RippleState::getJson (int)
 {
     Json::Value ret (Json::objectValue);
-    ret["low_id"] = to_string (mLowID);
-    ret["high_id"] = to_string (mHighID);
+    ret["low_id"] = to_string (mLowLimit.getIssuer ());
+    ret["high_id"] = to_string (mHighLimit.getIssuer ());
     return ret;
 }
 
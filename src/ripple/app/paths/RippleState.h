@@ -30,9 +30,12 @@ namespace ripple {
 
 /** Wraps a trust line SLE for convenience.
     The complication of trust lines is that there is a
-    "low" account and a "high" account. This wraps the
-    SLE and expresses its data from the perspective of
-    a chosen account on the line.
+    "low" account and a "high" account. This copies the
+    fields of the SLE and expresses them from the
+    perspective of a chosen account on the line.
+
+    The SLE itself is not kept, so that long lived
+    collections of lines stay small.
 */
 // VFALCO TODO Rename to TrustLine
 class RippleState
@@ -55,22 +58,22 @@ public:
         AccountID const& viewAccount);
 
     /** Returns the state map key for the ledger entry. */
-    uint256
+    uint256 const&
     key() const
     {
-        return mLedgerEntry->getIndex();
+        return mKey;
     }
 
     // VFALCO Take off the "get" from each function name
 
     AccountID const& getAccountID () const
     {
-        return  mViewLowest ? mLowID : mHighID;
+        return  mViewLowest ? mLowLimit.getIssuer () : mHighLimit.getIssuer ();
     }
 
     AccountID const& getAccountIDPeer () const
     {
-        return !mViewLowest ? mLowID : mHighID;
+        return !mViewLowest ? mLowLimit.getIssuer () : mHighLimit.getIssuer ();
     }
 
     // True, Provided auth to peer.
@@ -123,33 +126,30 @@ public:
 
     std::uint32_t getQualityIn () const
     {
-        return ((std::uint32_t) (mViewLowest ? mLowQualityIn : mHighQualityIn));
+        return mViewLowest ? mLowQualityIn : mHighQualityIn;
     }
 
     std::uint32_t getQualityOut () const
     {
-        return ((std::uint32_t) (mViewLowest ? mLowQualityOut : mHighQualityOut));
+        return mViewLowest ? mLowQualityOut : mHighQualityOut;
     }
 
     Json::Value getJson (int);
 
 private:
-    std::shared_ptr<SLE const> mLedgerEntry;
+    uint256                         mKey;
 
     bool                            mViewLowest;
 
     std::uint32_t                   mFlags;
 
-    STAmount const&                 mLowLimit;
-    STAmount const&                 mHighLimit;
-
-    AccountID const&                  mLowID;
-    AccountID const&                  mHighID;
+    STAmount                        mLowLimit;
+    STAmount                        mHighLimit;
 
-    std::uint64_t                   mLowQualityIn;
-    std::uint64_t                   mLowQualityOut;
-    std::uint64_t                   mHighQualityIn;
-    std::uint64_t                   mHighQualityOut;
+    std::uint32_t                   mLowQualityIn;
+    std::uint32_t                   mLowQualityOut;
+    std::uint32_t                   mHighQualityIn;
+    std::uint32_t                   mHighQualityOut;
 
     STAmount                        mBalance;
 };
@@ -0,0 +1,335 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/app/paths/TrustLineGraph.h>
+#include <ripple/basics/Log.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/STArray.h>
+
+namespace ripple {
+
+TrustLineGraph::TrustLineGraph (beast::Journal journal,
+        std::size_t hotLines)
+    : j_ (journal)
+    , hotLines_ (hotLines)
+{
+}
+
+LedgerIndex
+TrustLineGraph::seq () const
+{
+    std::lock_guard<std::mutex> sl (mutex_);
+    return seq_;
+}
+
+bool
+TrustLineGraph::follows (ReadView const& ledger) const
+{
+    return seq_ != 0 && !ledger.open() &&
+        ledger.info().seq == seq_ && ledger.info().hash == hash_;
+}
+
+void
+TrustLineGraph::advance (ReadView const& ledger)
+{
+    if (ledger.open())
+        return;
+
+    auto const& info = ledger.info();
+    bool patch;
+    {
+        std::lock_guard<std::mutex> sl (mutex_);
+        if (seq_ != 0 && info.hash == hash_)
+            return;
+        patch = seq_ != 0 && info.parentHash == hash_;
+    }
+
+    // Find the lines the ledger's transactions changed and read
+    // them before taking the lock.
+    hash_map<uint256, Change> changes;
+    if (patch)
+    {
+        for (auto const& tx : ledger.txs)
+        {
+            if (!tx.second)
+                continue;
+
+            for (auto const& node : tx.second->getFieldArray (sfAffectedNodes))
+            {
+                if (node.getFieldU16 (sfLedgerEntryType) != ltRIPPLE_STATE)
+                    continue;
+
+                auto const key = node.getFieldH256 (sfLedgerIndex);
+                if (changes.count (key))
+                    continue;
+
+                auto const& fields = (node.getFName () == sfCreatedNode)
+                    ? sfNewFields : sfFinalFields;
+                auto const data = dynamic_cast<STObject const*> (
+                    node.peekAtPField (fields));
+
+                if (!data ||
+                    !data->isFieldPresent (sfLowLimit) ||
+                    !data->isFieldPresent (sfHighLimit))
+                {
+                    JLOG (j_.warn()) <<
+                        "Trust line " << key << " missing from metadata";
+                    patch = false;
+                    break;
+                }
+
+                changes.emplace (key, Change {key,
+                    data->getFieldAmount (sfLowLimit).getIssuer (),
+                    data->getFieldAmount (sfHighLimit).getIssuer (),
+                    ledger.read (keylet::line (key))});
+            }
+
+            if (!patch)
+                break;
+        }
+    }
+
+    // Each account's lines are rebuilt once, however many
+    // of them changed.
+    hash_map<AccountID, std::vector<Change const*>> byAccount;
+    if (patch)
+    {
+        for (auto const& change : changes)
+        {
+            byAccount[change.second.low].push_back (&change.second);
+            byAccount[change.second.high].push_back (&change.second);
+        }
+    }
+
+    std::lock_guard<std::mutex> sl (mutex_);
+
+    // Someone else moved the graph in the meantime
+    if (seq_ != 0 && info.hash == hash_)
+        return;
+
+    if (patch && info.parentHash == hash_)
+    {
+        for (auto const& entry : byAccount)
+            apply (entry.first, entry.second);
+
+        JLOG (j_.debug()) <<
+            "Advanced to " << info.seq << ", " << changes.size () <<
+            " lines changed, " << lines_.size () << " accounts";
+    }
+    else
+    {
+        JLOG (j_.debug()) <<
+            "Starting over at " << info.seq << ", dropping " <<
+            lines_.size () << " accounts";
+
+        lines_.clear ();
+        counts_.clear ();
+    }
+
+    seq_ = info.seq;
+    hash_ = info.hash;
+}
+
+void
+TrustLineGraph::apply (AccountID const& account,
+    std::vector<Change const*> const& changes)
+{
+    auto const it = lines_.find (account);
+    if (it == lines_.end ())
+        return;
+
+    // The changed lines, seen from the account, by key
+    std::vector<RippleState::pointer> items;
+    items.reserve (changes.size ());
+    hash_map<uint256, std::size_t> index;
+    index.reserve (changes.size ());
+    for (auto const change : changes)
+    {
+        index.emplace (change->key, items.size ());
+        items.push_back (RippleState::makeItem (account, change->sle));
+    }
+    std::vector<char> placed (items.size (), false);
+
+    auto const counts = counts_.find (account);
+    auto const counted = counts != counts_.end ();
+
+    // Replacing in place and appending new lines keeps the
+    // order a fresh walk of the owner directory produces.
+    auto const& old = *it->second;
+    auto lines = std::make_shared<lines_type> ();
+    lines->reserve (old.size () + items.size ());
+    for (auto const& line : old)
+    {
+        auto const found = index.find (line->key ());
+        if (found == index.end ())
+        {
+            lines->push_back (line);
+            continue;
+        }
+
+        auto& item = items[found->second];
+        placed[found->second] = true;
+        if (counted)
+            count (counts->second, *line, -1);
+        if (item)
+        {
+            if (counted)
+                count (counts->second, *item, 1);
+            lines->push_back (std::move (item));
+        }
+    }
+
+    for (std::size_t i = 0; i < items.size (); ++i)
+    {
+        if (placed[i] || !items[i])
+            continue;
+        if (counted)
+            count (counts->second, *items[i], 1);
+        lines->push_back (std::move (items[i]));
+    }
+
+    if (counted)
+        counts->second.sets.reset ();
+    it->second = std::move (lines);
+}
+
+std::shared_ptr<TrustLineGraph::lines_type const>
+TrustLineGraph::getLines (AccountID const& account, ReadView const& ledger)
+{
+    {
+        std::lock_guard<std::mutex> sl (mutex_);
+        if (!follows (ledger))
+            return nullptr;
+
+        auto const it = lines_.find (account);
+        if (it != lines_.end ())
+            return it->second;
+    }
+
+    auto lines = std::make_shared<lines_type const> (
+        getRippleStateItems (account, ledger));
+
+    std::lock_guard<std::mutex> sl (mutex_);
+    if (follows (ledger) && lines_.size () < maxAccounts)
+        return lines_.emplace (account, std::move (lines)).first->second;
+    return lines;
+}
+
+std::shared_ptr<TrustLineGraph::Currencies const>
+TrustLineGraph::getCurrencies (AccountID const& account, ReadView const& ledger)
+{
+    {
+        std::lock_guard<std::mutex> sl (mutex_);
+        if (!follows (ledger))
+            return nullptr;
+
+        auto const it = counts_.find (account);
+        if (it != counts_.end ())
+            return sets (it->second);
+    }
+
+    auto const lines = getLines (account, ledger);
+    if (!lines || lines->size () < hotLines_)
+        return nullptr;
+
+    Counts counts;
+    for (auto const& line : *lines)
+        count (counts, *line, 1);
+
+    // The counts are only kept while they match the lines
+    // the graph holds, so that changes keep them current.
+    std::lock_guard<std::mutex> sl (mutex_);
+    auto const it = lines_.find (account);
+    if (follows (ledger) && it != lines_.end () && it->second == lines)
+        return sets (counts_.emplace (account, std::move (counts)).first->second);
+    return sets (counts);
+}
+
+TrustLineGraph::Currencies
+TrustLineGraph::currencies (lines_type const& lines)
+{
+    Currencies result;
+    for (auto const& line : lines)
+    {
+        auto const& currency = line->getBalance ().getCurrency ();
+        if (canSend (*line))
+            result.source.insert (currency);
+        if (canReceive (*line))
+            result.destination.insert (currency);
+    }
+    result.source.erase (badCurrency ());
+    result.destination.erase (badCurrency ());
+    return result;
+}
+
+bool
+TrustLineGraph::canSend (RippleState const& line)
+{
+    auto const& balance = line.getBalance ();
+
+    // Have IOUs to send, or the peer extends credit
+    return balance > zero ||
+        (line.getLimitPeer () && (-balance) < line.getLimitPeer ());
+}
+
+bool
+TrustLineGraph::canReceive (RippleState const& line)
+{
+    // Can take more
+    return line.getBalance () < line.getLimit ();
+}
+
+void
+TrustLineGraph::count (Counts& counts, RippleState const& line, int n)
+{
+    auto const& currency = line.getBalance ().getCurrency ();
+    auto adjust = [&](hash_map<Currency, int>& lines)
+    {
+        auto const it = lines.emplace (currency, 0).first;
+        it->second += n;
+        if (it->second == 0)
+            lines.erase (it);
+    };
+
+    if (canSend (line))
+        adjust (counts.source);
+    if (canReceive (line))
+        adjust (counts.destination);
+}
+
+std::shared_ptr<TrustLineGraph::Currencies const> const&
+TrustLineGraph::sets (Counts& counts)
+{
+    if (!counts.sets)
+    {
+        auto sets = std::make_shared<Currencies> ();
+        for (auto const& c : counts.source)
+            sets->source.insert (c.first);
+        for (auto const& c : counts.destination)
+            sets->destination.insert (c.first);
+        sets->source.erase (badCurrency ());
+        sets->destination.erase (badCurrency ());
+        counts.sets = std::move (sets);
+    }
+    return counts.sets;
+}
+
+} // ripple
@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_APP_PATHS_TRUSTLINEGRAPH_H_INCLUDED
+#define RIPPLE_APP_PATHS_TRUSTLINEGRAPH_H_INCLUDED
+
+#include <ripple/app/paths/RippleState.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/ledger/ReadView.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+/** The trust lines of accounts, kept from one ledger to the next.
+
+    A RippleLineCache lasts for one ledger and reads every account's
+    lines from its directory again. The graph instead follows the
+    closed ledgers pathfinding works on: when it moves to the next
+    ledger, only the lines that ledger's transactions touched are
+    read again, using the metadata to find them.
+
+    For accounts with many lines, such as gateways, the graph also
+    counts the lines that let the account send or receive each
+    currency. The counts are patched along with the lines, so the
+    currencies of those accounts are not found by scanning every
+    line again.
+
+    Lines are loaded the first time an account is asked for. An
+    account's lines are an immutable vector, replaced as a whole
+    when one of them changes, so callers may keep using what they
+    were given after the graph moves on.
+*/
+class TrustLineGraph
+{
+public:
+    using lines_type = std::vector<RippleState::pointer>;
+
+    /** The currencies an account can send and receive. */
+    struct Currencies
+    {
+        hash_set<Currency> source;
+        hash_set<Currency> destination;
+    };
+
+    /** Create a graph.
+
+        @param hotLines The number of lines from which an
+                        account's currencies are counted.
+    */
+    explicit
+    TrustLineGraph (beast::Journal journal,
+        std::size_t hotLines = 256);
+
+    /** Returns the ledger sequence the graph follows, or 0. */
+    LedgerIndex
+    seq () const;
+
+    /** Move the graph to a closed ledger.
+
+        If the ledger is the child of the one the graph follows, the
+        lines its transactions changed are updated in place. Otherwise
+        the graph starts over from this ledger.
+    */
+    void
+    advance (ReadView const& ledger);
+
+    /** Returns the lines of an account, seen from that account.
+
+        Returns nullptr unless the view is the ledger the graph
+        follows, in which case the caller reads the lines itself.
+    */
+    std::shared_ptr<lines_type const>
+    getLines (AccountID const& account, ReadView const& ledger);
+
+    /** Returns the currencies of an account with many lines.
+
+        Returns nullptr unless the view is the ledger the graph
+        follows and the account has at least hotLines lines.
+    */
+    std::shared_ptr<Currencies const>
+    getCurrencies (AccountID const& account, ReadView const& ledger);
+
+    /** Returns the currencies an account's lines let it use. */
+    static
+    Currencies
+    currencies (lines_type const& lines);
+
+    /** Returns true if the line lets its account send. */
+    static
+    bool
+    canSend (RippleState const& line);
+
+    /** Returns true if the line lets its account receive. */
+    static
+    bool
+    canReceive (RippleState const& line);
+
+private:
+    struct Change
+    {
+        uint256 key;
+        AccountID low;
+        AccountID high;
+        std::shared_ptr<SLE const> sle;
+    };
+
+    // Lines per currency, and the sets built from them
+    struct Counts
+    {
+        hash_map<Currency, int> source;
+        hash_map<Currency, int> destination;
+        std::shared_ptr<Currencies const> sets;
+    };
+
+    static
+    void
+    count (Counts& counts, RippleState const& line, int n);
+
+    static
+    std::shared_ptr<Currencies const> const&
+    sets (Counts& counts);
+
+    bool
+    follows (ReadView const& ledger) const;
+
+    void
+    apply (AccountID const& account,
+        std::vector<Change const*> const& changes);
+
+    // Bound on the accounts kept, lines of others are not retained
+    static std::size_t const maxAccounts = 65536;
+
+    beast::Journal j_;
+    std::size_t const hotLines_;
+
+    std::mutex mutable mutex_;
+    LedgerIndex seq_ = 0;
+    uint256 hash_;
+    hash_map<AccountID, std::shared_ptr<lines_type const>> lines_;
+    hash_map<AccountID, Counts> counts_;
+};
+
+} // ripple
+
+#endif
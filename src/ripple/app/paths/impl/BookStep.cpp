@@ -68,6 +68,13 @@ private:
 
     boost::optional<Cache> cache_;
 
+    // A payment can't change transfer rates, so the one
+    // read first is kept for the life of the strand.
+    boost::optional<std::uint32_t> transferRateIn_;
+
+    std::uint32_t
+    transferRateIn (ReadView const& sb);
+
 public:
     BookStep (Issue const& in,
         Issue const& out,
@@ -223,21 +230,11 @@ forEachOffer (
     PaymentSandbox& sb,
     ApplyView& afView,
     Book const& book,
-    AccountID const& src,
-    AccountID const& dst,
+    std::uint32_t trIn,
     Callback& callback,
     std::uint32_t limit,
     beast::Journal j)
 {
-    auto transferRate = [&](AccountID const& id)->std::uint32_t
-    {
-        if (isXRP (id) || id == src || id == dst)
-            return QUALITY_ONE;
-        return rippleTransferRate (sb, id);
-    };
-
-    std::uint32_t const trIn = transferRate (book.in.account);
-
     typename FlowOfferStream<TAmtIn, TAmtOut>::StepCounter counter (limit, j);
     FlowOfferStream<TAmtIn, TAmtOut> offers (
         sb, afView, book, sb.parentCloseTime (), counter, j);
@@ -267,6 +264,21 @@ forEachOffer (
     return {offers.permToRemove (), counter.count()};
 }
 
+template <class TIn, class TOut>
+std::uint32_t
+BookStep<TIn, TOut>::transferRateIn (ReadView const& sb)
+{
+    if (! transferRateIn_)
+    {
+        auto const& id = book_.in.account;
+        if (isXRP (id) || id == strandSrc_ || id == strandDst_)
+            transferRateIn_ = QUALITY_ONE;
+        else
+            transferRateIn_ = rippleTransferRate (sb, id);
+    }
+    return *transferRateIn_;
+}
+
 template <class TIn, class TOut>
 void BookStep<TIn, TOut>::consumeOffer (
     PaymentSandbox& sb,
@@ -364,8 +376,8 @@ BookStep<TIn, TOut>::revImp (
 
     {
         auto const r = forEachOffer<TIn, TOut> (
-            sb, afView, book_,
-            strandSrc_, strandDst_, eachOffer, maxOffersToConsume_, j_);
+            sb, afView, book_, transferRateIn (sb),
+            eachOffer, maxOffersToConsume_, j_);
         boost::container::flat_set<uint256> toRm = std::move(std::get<0>(r));
         std::uint32_t const offersConsumed = std::get<1>(r);
         ofrsToRm.insert (boost::container::ordered_unique_range_t{},
@@ -461,8 +473,8 @@ BookStep<TIn, TOut>::fwdImp (
 
     {
         auto const r = forEachOffer<TIn, TOut> (
-            sb, afView, book_,
-            strandSrc_, strandDst_, eachOffer, maxOffersToConsume_, j_);
+            sb, afView, book_, transferRateIn (sb),
+            eachOffer, maxOffersToConsume_, j_);
         boost::container::flat_set<uint256> toRm = std::move(std::get<0>(r));
         std::uint32_t const offersConsumed = std::get<1>(r);
         ofrsToRm.insert (boost::container::ordered_unique_range_t{},
@@ -63,11 +63,16 @@ class DirectStepI : public StepImp<IOUAmount, IOUAmount, DirectStepI>
 
     boost::optional<Cache> cache_;
 
+    // A payment can't change qualities or transfer rates, so the
+    // ones read first are kept for the life of the strand. Indexed
+    // by srcRedeems.
+    boost::optional<std::pair<std::uint32_t, std::uint32_t>> qualities_[2];
+
     // Returns srcQOut, dstQIn
     std::pair <std::uint32_t, std::uint32_t>
     qualities (
         PaymentSandbox& sb,
-        bool srcRedeems) const;
+        bool srcRedeems);
   public:
     DirectStepI (
         AccountID const& src,
@@ -499,11 +504,15 @@ quality (
 std::pair<std::uint32_t, std::uint32_t>
 DirectStepI::qualities (
     PaymentSandbox& sb,
-    bool srcRedeems) const
+    bool srcRedeems)
 {
+    auto& cached = qualities_[srcRedeems ? 1 : 0];
+    if (cached)
+        return *cached;
+
     if (srcRedeems)
     {
-        return std::make_pair(
+        cached.emplace (
             quality (
                 sb, src_, dst_, currency_,
                 false),
@@ -514,12 +523,13 @@ DirectStepI::qualities (
         // Charge a transfer rate when issuing, unless this is the first step.
         std::uint32_t const srcQOut =
             noTransferFee_ ? QUALITY_ONE : rippleTransferRate (sb, src_);
-        return std::make_pair(
+        cached.emplace (
             srcQOut,
             quality ( // dst quality in
                 sb, src_, dst_, currency_,
                 true));
     }
+    return *cached;
 }
 
 TER DirectStepI::check (StrandContext const& ctx) const
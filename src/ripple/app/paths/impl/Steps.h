@@ -58,6 +58,10 @@ class ApplyView;
    amount. Both `fwd` and `rev` return a pair of amounts (one for input amount,
    one for output amount) that show how much of the requested amount the step
    was actually able to use.
+
+   Steps remember inputs a payment can't change, such as transfer rates and
+   trust line qualities, the first time they read them. A strand must only be
+   used for one payment, against views of one ledger.
  */
 class Step
 {
@@ -147,12 +147,51 @@ public:
                 balance("evita", USD(150)), owners("evita", 150)));
     }
 
+    // Times one offer crossing 800 others, spread over more or fewer
+    // owners. The owners' funds are consulted for every offer crossed.
+    void
+    testCrossingThroughput(std::size_t makers)
+    {
+        testcase("crossing throughput, " + std::to_string(makers) + " makers");
+
+        using namespace jtx;
+        using namespace std::chrono;
+        Env env(*this);
+        env.disable_sigs();
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        std::size_t const offers = 800;
+
+        env.fund(XRP(100000000), gw, "alice");
+        env.trust(USD(1000000), "alice");
+        for (std::size_t i = 0; i < makers; ++i)
+        {
+            Account const maker("maker" + std::to_string(i));
+            env.fund(XRP(100000), maker);
+            env.trust(USD(1000), maker);
+            env(pay(gw, maker, USD(1000)));
+            n_offers (env, offers / makers, maker, XRP(1), USD(1));
+            env.close();
+        }
+
+        auto const start = steady_clock::now();
+        env(offer("alice", USD(offers), XRP(offers)),
+            require (balance("alice", USD(offers))));
+        auto const elapsed = steady_clock::now() - start;
+
+        log << duration_cast<microseconds>(elapsed).count() << "us, " <<
+            static_cast<std::uint64_t>(offers / duration_cast<
+                duration<double>>(elapsed).count()) << " offers crossed/s";
+    }
+
     void
     run()
     {
         testStepLimit();
         testCrossingLimit();
         testStepAndCrossingLimit();
+        testCrossingThroughput(4);
+        testCrossingThroughput(400);
     }
 };
 
@@ -783,5 +783,111 @@ struct Flow_test : public beast::unit_test::suite
 
 BEAST_DEFINE_TESTSUITE(Flow,app,ripple);
 
+//------------------------------------------------------------------------------
+
+// Payments across thin books, where every offer is at its own quality
+// and so takes an iteration of the flow loop.
+class Flow_timing_test : public beast::unit_test::suite
+{
+public:
+    template <class F>
+    std::chrono::duration<double>
+    timed (F&& f)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::steady_clock::now() - start;
+    }
+
+    // Issue path element
+    static auto IPE(Issue const& iss)
+    {
+        return STPathElement (
+            STPathElement::typeCurrency | STPathElement::typeIssuer,
+            xrpAccount (), iss.currency, iss.account);
+    };
+
+    void testThinBooks (std::size_t offers)
+    {
+        testcase ("thin books, " + std::to_string (offers) + " offers");
+
+        using namespace jtx;
+        using namespace std::chrono;
+
+        auto const gw = Account ("gateway");
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+        Account const alice ("alice");
+        Account const bob ("bob");
+        Account const carol ("carol");
+
+        Env env (*this, features(featureFlowV2));
+        env.disable_sigs ();
+
+        env.fund (XRP (100000000), alice, bob, carol, gw);
+        env (rate (gw, 1.002));
+        env.trust (USD (100000000), alice, bob, carol);
+        env.trust (EUR (100000000), alice, bob, carol);
+        env (pay (gw, alice, EUR (10000000)));
+        env (pay (gw, bob, USD (10000000)));
+        env (pay (gw, bob, EUR (10000000)));
+
+        // Half the offers are reached through XRP
+        for (std::size_t i = 0; i < offers; ++i)
+        {
+            if (i % 2)
+            {
+                env (offer (bob, EUR (100 + i), XRP (100)));
+                env (offer (bob, XRP (100), USD (100)));
+            }
+            else
+            {
+                env (offer (bob, EUR (100 + i), USD (100)));
+            }
+            if (i % 256 == 255)
+                env.close ();
+        }
+        env.close ();
+
+        STAmount const deliver (USD (25 * offers));
+        STAmount const smax (EUR (1000000));
+        STPathSet paths;
+        paths.push_back (STPath ({IPE (USD.issue ())}));
+        paths.push_back (STPath ({IPE (xrpIssue ()), IPE (USD.issue ())}));
+        auto const j = env.app ().logs ().journal ("Flow");
+
+        std::size_t const runs = 5;
+        boost::optional<STAmount> in;
+        auto const elapsed = timed ([&]
+        {
+            for (std::size_t i = 0; i < runs; ++i)
+            {
+                PaymentSandbox sb (env.closed ().get (), tapNONE);
+                auto const r = flow (sb, deliver, alice, carol, paths,
+                    false, false, boost::none, smax, j);
+                expect (r.result () == tesSUCCESS);
+                expect (r.actualAmountOut == deliver);
+
+                // Every run over the same ledger spends the same amount
+                if (! in)
+                    in = r.actualAmountIn;
+                expect (r.actualAmountIn == *in);
+            }
+        });
+
+        log << duration_cast<microseconds>(elapsed).count () / runs <<
+            "us per payment, " << (in ? in->getFullText () : "nothing") <<
+                " spent";
+    }
+
+    void run() override
+    {
+        testThinBooks (200);
+        testThinBooks (800);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(Flow_timing,app,ripple);
+
 } // test
 } // ripple
@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class ParallelApply_test : public beast::unit_test::suite
+{
+    // Build the same ledgers with the given number of apply
+    // threads and return the hash of each one that was closed.
+    std::vector<uint256>
+    build (std::size_t threads)
+    {
+        using namespace jtx;
+
+        auto config = std::make_unique<Config>();
+        setupConfigForUnitTests (*config);
+        config->APPLY_THREADS = threads;
+        Env env (*this, std::move (config));
+
+        std::vector<uint256> hashes;
+        auto close = [&]()
+        {
+            env.close();
+            hashes.push_back (env.closed()->info().hash);
+        };
+
+        auto const gw = Account ("gateway");
+        auto const USD = gw["USD"];
+        std::vector<Account> accounts;
+        for (int i = 0; i < 20; ++i)
+            accounts.emplace_back ("a" + std::to_string (i));
+
+        // Every funding payment comes from the master account
+        for (auto const& a : accounts)
+            env.fund (XRP (10000), a);
+        env.fund (XRP (10000), gw);
+        close();
+
+        for (auto const& a : accounts)
+            env.trust (USD (1000), a);
+        close();
+
+        // Disjoint payments, then payments sharing a
+        // destination, then offers, which walk books.
+        for (std::size_t i = 0; i + 1 < accounts.size(); i += 2)
+            env (pay (accounts[i], accounts[i + 1], XRP (10)));
+        for (std::size_t i = 1; i < accounts.size(); ++i)
+            env (pay (accounts[i], accounts[0], XRP (1)));
+        for (std::size_t i = 0; i < accounts.size(); ++i)
+            env (pay (gw, accounts[i], USD (100)));
+        close();
+
+        for (std::size_t i = 0; i < accounts.size(); ++i)
+            env (offer (accounts[i], XRP (10 + i), USD (10)));
+        for (std::size_t i = 0; i < accounts.size(); ++i)
+            env (offer (accounts[i], USD (10), XRP (20)));
+        close();
+
+        return hashes;
+    }
+
+public:
+    void
+    run() override
+    {
+        auto const serial = build (0);
+        expect (build (2) == serial, "Two threads");
+        expect (build (8) == serial, "Eight threads");
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ParallelApply,app,ripple);
+
+} // test
+} // ripple
@@ -0,0 +1,496 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/app/paths/Flow.h>
+#include <ripple/app/paths/Pathfinder.h>
+#include <ripple/app/paths/RippleCalc.h>
+#include <ripple/app/paths/RippleLineCache.h>
+#include <ripple/app/paths/impl/Steps.h>
+#include <ripple/app/paths/impl/StrandFlow.h>
+#include <ripple/basics/AllocationCounter.h>
+#include <ripple/beast/core/LexicalCast.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/ledger/PaymentSandbox.h>
+#include <ripple/protocol/AmountConversions.h>
+#include <ripple/test/jtx.h>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <numeric>
+#include <random>
+
+namespace ripple {
+namespace test {
+
+/*  Measures pathfinding and the payment engines on generated graphs.
+
+    Gateways issue USD and EUR. Accounts trust a few gateways for
+    both and hold some of each. Market makers quote EUR for USD
+    between every pair of gateways, several offers deep, and a chain
+    of accounts ripples USD from one end to the other.
+
+    Parameters are passed as "name=value,..." in the suite argument:
+
+        accounts    Accounts holding balances           (1000)
+        gateways    Gateways issuing USD and EUR          (8)
+        makers      Market makers                         (2)
+        depth       Offers per book from each maker       (5)
+        chain       Accounts in the rippling chain        (8)
+        requests    Path requests to run                 (40)
+        level       Search level                          (7)
+        budget      Search time limit in milliseconds     (0)
+        repeat      Evaluations of each strand           (10)
+        seed        Random seed                           (1)
+
+    The interim pass is the extra ranking and liquidity check that a
+    path_find request does to send the fast search's paths early,
+    before its first full reply.
+
+    Allocations are reported when built with RIPPLE_COUNT_ALLOCATIONS.
+*/
+class PathBenchmark_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    struct Params
+    {
+        std::size_t accounts = 1000;
+        std::size_t gateways = 8;
+        std::size_t makers = 2;
+        std::size_t depth = 5;
+        std::size_t chain = 8;
+        std::size_t requests = 40;
+        std::size_t level = 7;
+        std::size_t budget = 0;
+        std::size_t repeat = 10;
+        std::size_t seed = 1;
+    };
+
+    struct Graph
+    {
+        std::vector<jtx::Account> gateways;
+        std::vector<jtx::Account> accounts;
+        std::vector<jtx::Account> makers;
+        std::vector<jtx::Account> chain;
+    };
+
+    struct Request
+    {
+        AccountID src;
+        AccountID dst;
+        Currency srcCurrency;
+        STAmount deliver;
+    };
+
+    // What one measured call cost
+    struct Sample
+    {
+        clock_type::duration elapsed {0};
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+
+        Sample
+        operator+ (Sample const& other) const
+        {
+            return { elapsed + other.elapsed,
+                allocations + other.allocations, bytes + other.bytes };
+        }
+
+        Sample
+        operator/ (std::size_t n) const
+        {
+            return { elapsed / n, allocations / n, bytes / n };
+        }
+    };
+
+    // Durations and allocations of one kind of measurement
+    class Stats
+    {
+    private:
+        std::vector<double> us_;
+        std::uint64_t allocations_ = 0;
+        std::uint64_t bytes_ = 0;
+
+    public:
+        void
+        add (Sample const& sample)
+        {
+            using namespace std::chrono;
+            us_.push_back (duration_cast<duration<double, std::micro>>(
+                sample.elapsed).count ());
+            allocations_ += sample.allocations;
+            bytes_ += sample.bytes;
+        }
+
+        std::size_t
+        size () const
+        {
+            return us_.size ();
+        }
+
+        std::string
+        report ()
+        {
+            if (us_.empty ())
+                return "no samples";
+            std::sort (us_.begin (), us_.end ());
+            auto const mean = std::accumulate (
+                us_.begin (), us_.end (), 0.0) / us_.size ();
+            std::string s =
+                std::to_string (us_.size ()) + " samples, mean " +
+                std::to_string (static_cast<std::uint64_t> (mean)) +
+                "us, median " +
+                std::to_string (static_cast<std::uint64_t> (
+                    us_[us_.size () / 2])) +
+                "us, max " +
+                std::to_string (static_cast<std::uint64_t> (us_.back ())) +
+                "us";
+            if (AllocationCounter::enabled ())
+                s += ", " + std::to_string (allocations_ / us_.size ()) +
+                    " allocations of " + std::to_string (
+                        bytes_ / us_.size ()) + " bytes each";
+            return s;
+        }
+    };
+
+    Params
+    parseParams ()
+    {
+        Params p;
+        std::map<std::string, std::size_t*> const fields {
+            { "accounts", &p.accounts },
+            { "gateways", &p.gateways },
+            { "makers",   &p.makers },
+            { "depth",    &p.depth },
+            { "chain",    &p.chain },
+            { "requests", &p.requests },
+            { "level",    &p.level },
+            { "budget",   &p.budget },
+            { "repeat",   &p.repeat },
+            { "seed",     &p.seed } };
+
+        std::vector<std::string> items;
+        boost::split (items, arg (), boost::algorithm::is_any_of (","));
+        for (auto const& item : items)
+        {
+            if (item.empty ())
+                continue;
+            std::vector<std::string> kv;
+            boost::split (kv, item, boost::algorithm::is_any_of ("="));
+            auto const it = fields.find (boost::trim_copy (kv[0]));
+            if (kv.size () != 2 || it == fields.end ())
+            {
+                log << "Ignoring parameter " << item;
+                continue;
+            }
+            *it->second = beast::lexicalCastThrow<std::size_t> (
+                boost::trim_copy (kv[1]));
+        }
+        return p;
+    }
+
+    template <class F>
+    Sample
+    measure (F&& f)
+    {
+        AllocationCounter allocations;
+        auto const start = clock_type::now ();
+        f ();
+        auto const elapsed = clock_type::now () - start;
+        return { elapsed, allocations.count (), allocations.bytes () };
+    }
+
+    Graph
+    build (jtx::Env& env, Params const& p)
+    {
+        using namespace jtx;
+        std::mt19937 rng (static_cast<std::uint32_t> (p.seed));
+        Graph g;
+
+        auto const name = [](std::string const& s, std::size_t i)
+        {
+            return s + std::to_string (i);
+        };
+        for (std::size_t i = 0; i < p.gateways; ++i)
+            g.gateways.emplace_back (name ("gateway", i));
+        for (std::size_t i = 0; i < p.accounts; ++i)
+            g.accounts.emplace_back (name ("account", i));
+        for (std::size_t i = 0; i < p.makers; ++i)
+            g.makers.emplace_back (name ("maker", i));
+        for (std::size_t i = 0; i < p.chain; ++i)
+            g.chain.emplace_back (name ("chain", i));
+
+        // Keep the open ledger small while building
+        std::size_t txs = 0;
+        auto const tick = [&env, &txs]
+        {
+            if (++txs % 256 == 0)
+                env.close ();
+        };
+
+        for (auto const* v : { &g.gateways, &g.accounts, &g.makers, &g.chain })
+        {
+            for (auto const& a : *v)
+            {
+                env.fund (XRP(10000000), a);
+                tick ();
+            }
+        }
+        env.close ();
+
+        for (auto const& a : g.accounts)
+        {
+            for (int k = 0; k < 2; ++k)
+            {
+                auto const& gw = g.gateways[rng () % g.gateways.size ()];
+                env (trust (a, gw["USD"](1000000)));
+                env (trust (a, gw["EUR"](1000000)));
+                env (pay (gw, a, gw["USD"](1000)));
+                env (pay (gw, a, gw["EUR"](1000)));
+                tick ();
+            }
+        }
+
+        for (auto const& m : g.makers)
+        {
+            for (auto const& gw : g.gateways)
+            {
+                env (trust (m, gw["USD"](100000000)));
+                env (trust (m, gw["EUR"](100000000)));
+                env (pay (gw, m, gw["USD"](10000000)));
+                tick ();
+            }
+        }
+
+        // Each maker's offers get worse the deeper they are in a book
+        for (auto const& m : g.makers)
+            for (auto const& in : g.gateways)
+                for (auto const& out : g.gateways)
+                    for (std::size_t d = 0; d < p.depth; ++d)
+                    {
+                        env (offer (m, in["EUR"](100 + d + rng () % 10),
+                            out["USD"](100)));
+                        tick ();
+                    }
+
+        // Every link of the chain extends credit to the one before
+        if (! g.chain.empty ())
+        {
+            auto const& gw = g.gateways.front ();
+            env (trust (g.chain.front (), gw["USD"](1000000)));
+            env (pay (gw, g.chain.front (), gw["USD"](10000)));
+            for (std::size_t i = 1; i < g.chain.size (); ++i)
+            {
+                env (trust (g.chain[i], g.chain[i - 1]["USD"](1000000)));
+                tick ();
+            }
+        }
+
+        env.close ();
+        return g;
+    }
+
+    std::vector<Request>
+    makeRequests (Graph const& g, Params const& p)
+    {
+        std::vector<Request> requests;
+        auto const n = g.accounts.size ();
+        if (n < 2)
+            return requests;
+
+        for (std::size_t r = 0; r < p.requests; ++r)
+        {
+            auto const& src = g.accounts[r % n];
+            auto const& dst = g.accounts[(r * 7 + n / 2) % n];
+            if (src == dst)
+                continue;
+
+            // Alternate same currency and cross currency requests
+            requests.push_back ({src.id (), dst.id (),
+                to_currency ((r % 2) ? "EUR" : "USD"), dst["USD"](10)});
+        }
+
+        if (g.chain.size () > 1)
+            requests.push_back ({g.chain.front ().id (),
+                g.chain.back ().id (), to_currency ("USD"),
+                    g.chain.back ()["USD"](10)});
+
+        return requests;
+    }
+
+    void
+    testBenchmark ()
+    {
+        using namespace jtx;
+        auto const p = parseParams ();
+        testcase ("paths, " + std::to_string (p.accounts) + " accounts, " +
+            std::to_string (p.gateways) + " gateways");
+
+        Env env (*this);
+        env.disable_sigs ();
+        auto const j = env.app ().journal ("PathBenchmark");
+
+        Graph g;
+        auto const built = measure ([&]{ g = build (env, p); });
+        log << "built graph in " << std::chrono::duration_cast<
+            std::chrono::milliseconds>(built.elapsed).count () << "ms";
+        auto const requests = makeRequests (g, p);
+
+        Stats first;
+        Stats interim;
+        Stats search;
+        Stats strands;
+        Stats flowPay;
+        Stats calcPay;
+        std::size_t found = 0;
+        std::size_t foundFirst = 0;
+        std::size_t timedOut = 0;
+
+        auto const ledger = env.closed ();
+        auto const cache = std::make_shared<RippleLineCache> (ledger);
+
+        for (auto const& r : requests)
+        {
+            // A fast search first, then deepened to the full level,
+            // the way path_find subscribers are served.
+            STPathSet paths;
+            Pathfinder pf (cache, r.src, r.dst, r.srcCurrency,
+                boost::none, r.deliver, boost::none, env.app ());
+            if (p.budget > 0)
+                pf.setDeadline (Pathfinder::clock_type::now () +
+                    std::chrono::milliseconds (p.budget));
+            auto const best = [&]
+            {
+                pf.computePathRanks (4);
+                STPath fullLiquidityPath;
+                paths = pf.getBestPaths (4, fullLiquidityPath,
+                    STPathSet (), r.src);
+            };
+
+            auto const f1 = measure ([&]
+            {
+                pf.findPaths (std::min<int> (
+                    env.app ().config ().PATH_SEARCH_FAST, p.level));
+            });
+
+            // Ranking and checking the liquidity of the fast paths is
+            // only needed to send them early, so it is reported apart.
+            auto const i = measure ([&]
+            {
+                best ();
+                if (paths.empty ())
+                    return;
+                PaymentSandbox sb (ledger.get (), tapNONE);
+                ripple::path::RippleCalc::rippleCalculate (sb,
+                    STAmount ({r.srcCurrency, r.src}, 1u, 0, true),
+                    r.deliver, r.dst, r.src, paths,
+                    env.app ().logs (), env.app ().config ());
+            });
+            first.add (f1 + i);
+            interim.add (i);
+            if (! paths.empty ())
+                ++foundFirst;
+
+            auto const f2 = measure ([&]
+            {
+                if (pf.findPaths (static_cast<int> (p.level)))
+                    best ();
+            });
+            search.add (f1 + f2);
+            if (pf.timedOut ())
+                ++timedOut;
+
+            if (paths.empty ())
+                continue;
+            ++found;
+
+            // Evaluate each strand on its own, as the flow loop does
+            {
+                PaymentSandbox sb (ledger.get (), tapNONE);
+                auto const sr = toStrands (sb, r.src, r.dst,
+                    r.deliver.issue (), Issue (r.srcCurrency, r.src),
+                        paths, true, j);
+                if (sr.first == tesSUCCESS)
+                {
+                    auto const out = toAmount<IOUAmount> (r.deliver);
+                    for (auto const& strand : sr.second)
+                    {
+                        auto const e = measure ([&]
+                        {
+                            for (std::size_t i = 0; i < p.repeat; ++i)
+                                flow<IOUAmount, IOUAmount> (
+                                    sb, strand, boost::none, out, j);
+                        });
+                        strands.add (e / p.repeat);
+                    }
+                }
+            }
+
+            // The whole payment through both engines
+            auto const f = measure ([&]
+            {
+                PaymentSandbox sb (ledger.get (), tapNONE);
+                flow (sb, r.deliver, r.src, r.dst, paths, true,
+                    false, boost::none, boost::none, j);
+            });
+            flowPay.add (f);
+
+            auto const c = measure ([&]
+            {
+                PaymentSandbox sb (ledger.get (), tapNONE);
+                ripple::path::RippleCalc::rippleCalculate (sb,
+                    STAmount ({r.srcCurrency, r.src}, 1u, 0, true),
+                    r.deliver, r.dst, r.src, paths,
+                    env.app ().logs (), env.app ().config ());
+            });
+            calcPay.add (c);
+        }
+
+        log << "first result: " << first.report ();
+        log << "  " << foundFirst << " of " << requests.size () <<
+            " requests found paths";
+        log << "interim pass: " << interim.report ();
+        log << "path search: " << search.report ();
+        log << "  " << found << " of " << requests.size () <<
+            " requests found paths, " << timedOut << " ran out of time";
+        log << "strand flow: " << strands.report ();
+        log << "flow payment: " << flowPay.report ();
+        log << "RippleCalc payment: " << calcPay.report ();
+        if (! AllocationCounter::enabled ())
+            log << "Build with RIPPLE_COUNT_ALLOCATIONS to count allocations";
+
+        pass ();
+        expect (search.size () == requests.size ());
+    }
+
+    void
+    run () override
+    {
+        testBenchmark ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(PathBenchmark,app,ripple);
+
+} // test
+} // ripple
@@ -19,6 +19,10 @@
 
 #include <BeastConfig.h>
 #include <ripple/app/paths/AccountCurrencies.h>
+#include <ripple/app/paths/PathRequests.h>
+#include <ripple/app/paths/Pathfinder.h>
+#include <ripple/app/paths/RippleCalc.h>
+#include <ripple/basics/AllocationCounter.h>
 #include <ripple/basics/contract.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/json/json_reader.h>
@@ -396,6 +400,87 @@ public:
         expect(equal(sa, Account("alice")["USD"](5)));
     }
 
+    void
+    path_find_cached()
+    {
+        testcase("path find cached");
+        using namespace jtx;
+        Env env(*this);
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), "alice", "bob", gw);
+        env.trust(USD(600), "alice");
+        env.trust(USD(700), "bob");
+        env(pay(gw, "alice", USD(70)));
+        env(pay(gw, "bob", USD(50)));
+        env.close();
+
+        auto find = [&](STAmount const& amount)
+        {
+            auto cache = std::make_shared<RippleLineCache>(env.closed());
+            Pathfinder pf(cache, Account("alice"), Account("bob"),
+                USD.currency, boost::none, amount, boost::none, env.app());
+            expect(pf.findPaths(8));
+            pf.computePathRanks(4);
+            STPath fullLiquidityPath;
+            return pf.getBestPaths(4, fullLiquidityPath, STPathSet(),
+                Account("alice"));
+        };
+
+        auto& pathCache = env.app().getPathRequests().getPathCache();
+        expect(same(find(Account("bob")["USD"](5)), stpath("gateway")));
+        auto const rate = pathCache.getHitRate();
+
+        // An amount of the same magnitude reuses the candidates
+        expect(same(find(Account("bob")["USD"](7)), stpath("gateway")));
+        expect(pathCache.getHitRate() > rate);
+
+        // Lookups on the open ledger can never hit, so they
+        // leave the hit rate alone
+        auto const closedRate = pathCache.getHitRate();
+        STPathSet paths;
+        expect(! pathCache.find(*env.current(), PathCache::Key{}, paths));
+        expect(pathCache.getHitRate() == closedRate);
+    }
+
+    void
+    path_find_deadline()
+    {
+        testcase("path find deadline");
+        using namespace jtx;
+        Env env(*this);
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), "alice", "bob", gw);
+        env.trust(USD(600), "alice");
+        env.trust(USD(700), "bob");
+        env(pay(gw, "alice", USD(70)));
+        env(pay(gw, "bob", USD(50)));
+        env.close();
+
+        auto find = [&](boost::optional<
+            Pathfinder::clock_type::time_point> deadline)
+        {
+            auto cache = std::make_shared<RippleLineCache>(env.closed());
+            Pathfinder pf(cache, Account("alice"), Account("bob"),
+                USD.currency, boost::none, Account("bob")["USD"](5),
+                    boost::none, env.app());
+            if (deadline)
+                pf.setDeadline(*deadline);
+            expect(pf.findPaths(8));
+            expect(pf.timedOut() == static_cast<bool>(deadline));
+            pf.computePathRanks(4);
+            STPath fullLiquidityPath;
+            return pf.getBestPaths(4, fullLiquidityPath, STPathSet(),
+                Account("alice"));
+        };
+
+        // A search out of time still finds what a fast search
+        // would, and is not cached
+        expect(same(find(Pathfinder::clock_type::now()), stpath("gateway")));
+        expect(same(find(boost::none), stpath("gateway")));
+    }
+
     void
     xrp_to_xrp()
     {
@@ -846,6 +931,8 @@ public:
         direct_path_no_intermediary();
         payment_auto_path_find();
         path_find();
+        path_find_cached();
+        path_find_deadline();
         path_find_consume_all();
         alternative_path_consume_both();
         alternative_paths_consume_best_transfer();
@@ -865,5 +952,153 @@ public:
 
 BEAST_DEFINE_TESTSUITE(Path,app,ripple)
 
+//------------------------------------------------------------------------------
+
+// Cross currency searches over many gateways, which leave hundreds
+// of candidate paths to rank.
+class Path_timing_test : public beast::unit_test::suite
+{
+public:
+    template <class F>
+    std::chrono::duration<double>
+    timed (F&& f)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::steady_clock::now() - start;
+    }
+
+    void
+    testRankPaths (std::size_t gateways)
+    {
+        testcase ("rank paths, " + std::to_string (gateways) + " gateways");
+
+        using namespace jtx;
+        using namespace std::chrono;
+        Env env(*this);
+        env.disable_sigs();
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        auto const market = Account("market");
+        std::vector<Account> gws;
+        for (std::size_t i = 0; i < gateways; ++i)
+            gws.emplace_back ("gateway" + std::to_string (i));
+
+        env.fund(XRP(1000000), alice, bob, market);
+        for (auto const& gw : gws)
+            env.fund(XRP(1000000), gw);
+        env.close();
+
+        for (auto const& gw : gws)
+        {
+            env.trust(gw["EUR"](1000000), alice, market);
+            env.trust(gw["USD"](1000000), bob, market);
+            env(pay(gw, alice, gw["EUR"](10000)));
+            env(pay(gw, market, gw["USD"](10000)));
+        }
+        for (auto const& in : gws)
+            for (auto const& out : gws)
+                env(offer(market, in["EUR"](100), out["USD"](100)));
+        env.close();
+
+        auto rank = [&](std::size_t jobs, STPathSet& best)
+        {
+            auto cache = std::make_shared<RippleLineCache>(env.closed());
+            Pathfinder pf(cache, alice, bob, to_currency("EUR"),
+                boost::none, bob["USD"](50), boost::none, env.app());
+            pf.setRankJobs(jobs);
+            expect(pf.findPaths(7));
+            auto const elapsed = timed ([&]{ pf.computePathRanks(4); });
+            STPath fullLiquidityPath;
+            best = pf.getBestPaths(4, fullLiquidityPath, STPathSet(), alice);
+            return elapsed;
+        };
+
+        STPathSet serialBest;
+        STPathSet parallelBest;
+        auto const serial = rank (1, serialBest);
+        auto const jobs = Pathfinder::maxJobs (env.app().config());
+        auto const parallel = rank (jobs, parallelBest);
+
+        // The ranking must not depend on the number of jobs
+        expect (serialBest.size() == parallelBest.size());
+        for (std::size_t i = 0;
+                i < std::min(serialBest.size(), parallelBest.size()); ++i)
+            expect (serialBest[i] == parallelBest[i]);
+
+        log << "serial " << duration_cast<milliseconds>(serial).count() <<
+            "ms, " << jobs << " jobs " <<
+            duration_cast<milliseconds>(parallel).count() << "ms";
+    }
+
+    // A payment carrying one path through each gateway, each with
+    // a little liquidity, so every pass evaluates many path states.
+    void
+    testRippleCalc (std::size_t gateways)
+    {
+        testcase ("RippleCalc, " + std::to_string (gateways) + " paths");
+
+        using namespace jtx;
+        using namespace std::chrono;
+        Env env(*this);
+        env.disable_sigs();
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        std::vector<Account> gws;
+        for (std::size_t i = 0; i < gateways; ++i)
+            gws.emplace_back ("gateway" + std::to_string (i));
+
+        env.fund(XRP(1000000), alice, bob);
+        for (auto const& gw : gws)
+            env.fund(XRP(1000000), gw);
+        env.close();
+
+        STPathSet paths;
+        for (auto const& gw : gws)
+        {
+            env.trust(gw["USD"](1000), alice, bob);
+            env(pay(gw, alice, gw["USD"](10)));
+            paths.push_back (STPath ({STPathElement (
+                gw.id(), boost::none, boost::none)}));
+        }
+        env.close();
+
+        auto const deliver = bob["USD"](5 * gateways);
+        auto const sendMax = alice["USD"](10 * gateways);
+        ripple::path::RippleCalc::Input inputs;
+        inputs.defaultPathsAllowed = false;
+
+        std::uint64_t allocations = 0;
+        auto const elapsed = timed ([&]
+        {
+            AllocationCounter counter;
+            PaymentSandbox sb (env.closed().get(), tapNONE);
+            auto const out = ripple::path::RippleCalc::rippleCalculate (sb,
+                sendMax, deliver, bob, alice, paths,
+                env.app().logs(), env.app().config(), &inputs);
+            allocations = counter.count();
+            expect (out.result() == tesSUCCESS);
+            expect (out.actualAmountOut == deliver);
+        });
+
+        log << duration_cast<microseconds>(elapsed).count() << "us";
+        if (AllocationCounter::enabled ())
+            log << allocations << " allocations";
+        else
+            log << "Build with RIPPLE_COUNT_ALLOCATIONS to count allocations";
+    }
+
+    void
+    run() override
+    {
+        testRankPaths (4);
+        testRankPaths (16);
+        testRippleCalc (16);
+        testRippleCalc (128);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(Path_timing,app,ripple);
+
 } // test
 } // ripple
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/app/ledger/TransactionMaster.h>
+#include <ripple/protocol/JsonFields.h>
+#include <ripple/protocol/Serializer.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+struct TransactionMaster_test : public beast::unit_test::suite
+{
+    static
+    Serializer
+    serialize (STTx const& tx)
+    {
+        Serializer s;
+        tx.add (s);
+        return s;
+    }
+
+    void
+    testParse()
+    {
+        testcase ("parse");
+
+        using namespace jtx;
+        Env env (*this);
+        auto const alice = Account ("alice");
+        env.fund (XRP(10000), alice);
+        env.close();
+
+        auto& master = env.app().getMasterTransaction();
+        auto& cache = master.getParsedCache();
+
+        auto const tx1 = env.jt (noop (alice)).stx;
+        auto const tx2 = env.jt (noop (alice), seq (tx1->getSequence() + 1)).stx;
+        auto const tx3 = env.jt (noop (alice), seq (tx1->getSequence() + 2)).stx;
+        auto const s1 = serialize (*tx1);
+        auto const s3 = serialize (*tx3);
+
+        // Parsing the same transaction again returns the same object
+        auto const a = master.parse (s1.slice());
+        expect (a->getTransactionID() == tx1->getTransactionID());
+        auto const b = master.parse (s1.slice());
+        expect (a == b);
+        expect (master.parse (tx1->getTransactionID(), s1.slice()) == a);
+
+        // Data which does not hash to the given ID is parsed, but
+        // not cached under either ID
+        auto const size = cache.getCacheSize();
+        auto const c = master.parse (tx2->getTransactionID(), s3.slice());
+        expect (c->getTransactionID() == tx3->getTransactionID());
+        expect (cache.getCacheSize() == size);
+        expect (! cache.fetch (tx2->getTransactionID()));
+        expect (master.parse (s3.slice()) != c);
+    }
+
+    void
+    testGetCounts()
+    {
+        testcase ("get_counts");
+
+        using namespace jtx;
+        Env env (*this);
+        auto const alice = Account ("alice");
+        env.fund (XRP(10000), alice);
+        env.close();
+
+        auto& master = env.app().getMasterTransaction();
+        auto& cache = master.getParsedCache();
+
+        auto const s = serialize (*env.jt (noop (alice)).stx);
+        cache.clearStats();
+        master.parse (s.slice());   // miss
+        master.parse (s.slice());   // hit
+
+        auto const result = env.rpc ("get_counts")[jss::result];
+        expect (result.isMember (jss::STTx_hit_rate));
+        expect (result.isMember (jss::STTx_cache_size));
+        expect (result[jss::STTx_hit_rate].asDouble() == 50);
+        expect (result[jss::STTx_cache_size].asInt() ==
+            cache.getCacheSize());
+        expect (cache.getCacheSize() > 0);
+    }
+
+    void
+    run() override
+    {
+        testParse();
+        testGetCounts();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TransactionMaster,app,ripple);
+
+} // test
+} // ripple
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/app/paths/TrustLineGraph.h>
+#include <ripple/test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+struct TrustLineGraph_test : public beast::unit_test::suite
+{
+    // The graph must agree with a fresh walk of the owner directory
+    void
+    expectLines (TrustLineGraph& graph,
+        ReadView const& view, jtx::Account const& account)
+    {
+        auto const lines = graph.getLines (account.id(), view);
+        if (! expect (lines, account.name()))
+            return;
+        auto const fresh = getRippleStateItems (account.id(), view);
+        if (! expect (lines->size() == fresh.size(), account.name()))
+            return;
+        for (std::size_t i = 0; i < fresh.size(); ++i)
+        {
+            auto const& a = *(*lines)[i];
+            auto const& b = *fresh[i];
+            expect (a.key() == b.key());
+            expect (a.getAccountID() == b.getAccountID());
+            expect (a.getAccountIDPeer() == b.getAccountIDPeer());
+            expect (a.getBalance() == b.getBalance());
+            expect (a.getLimit() == b.getLimit());
+            expect (a.getLimitPeer() == b.getLimitPeer());
+            expect (a.getNoRipple() == b.getNoRipple());
+            expect (a.getNoRipplePeer() == b.getNoRipplePeer());
+            expect (a.getQualityIn() == b.getQualityIn());
+            expect (a.getQualityOut() == b.getQualityOut());
+        }
+    }
+
+    void
+    testAdvance()
+    {
+        using namespace jtx;
+        auto const gw = Account ("gw");
+        auto const alice = Account ("alice");
+        auto const bob = Account ("bob");
+        auto const carol = Account ("carol");
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+
+        Env env (*this);
+        env.fund (XRP(10000), alice, bob, carol, gw);
+        env.trust (USD(1000), alice, bob);
+        env.close();
+
+        TrustLineGraph graph ((beast::Journal()));
+        expect (graph.seq() == 0);
+        expect (! graph.getLines (gw.id(), *env.closed()));
+
+        graph.advance (*env.closed());
+        expect (graph.seq() == env.closed()->seq());
+        expect (! graph.getLines (gw.id(), *env.current()));
+        for (auto const& account : { gw, alice, bob, carol })
+            expectLines (graph, *env.closed(), account);
+
+        // Change a balance, add a line and remove one
+        env (pay (gw, alice, USD(100)));
+        env.trust (EUR(500), carol);
+        env (trust (bob, USD(0)));
+        env.close();
+
+        expect (! graph.getLines (gw.id(), *env.closed()));
+        graph.advance (*env.closed());
+        expect (graph.seq() == env.closed()->seq());
+        for (auto const& account : { gw, alice, bob, carol })
+            expectLines (graph, *env.closed(), account);
+
+        // After a gap the graph starts over
+        env (pay (alice, gw, USD(10)));
+        env.close();
+        env (pay (gw, carol, EUR(10)));
+        env.close();
+
+        graph.advance (*env.closed());
+        expect (graph.seq() == env.closed()->seq());
+        for (auto const& account : { gw, alice, bob, carol })
+            expectLines (graph, *env.closed(), account);
+    }
+
+    // Counted currencies must agree with a scan of the lines
+    void
+    expectCurrencies (TrustLineGraph& graph,
+        ReadView const& view, jtx::Account const& account)
+    {
+        auto const counted = graph.getCurrencies (account.id(), view);
+        if (! expect (counted, account.name()))
+            return;
+        auto const fresh = TrustLineGraph::currencies (
+            getRippleStateItems (account.id(), view));
+        expect (counted->source == fresh.source, account.name());
+        expect (counted->destination == fresh.destination, account.name());
+    }
+
+    void
+    testCurrencies()
+    {
+        using namespace jtx;
+        auto const gw = Account ("gw");
+        auto const alice = Account ("alice");
+        auto const bob = Account ("bob");
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+
+        Env env (*this);
+        env.fund (XRP(10000), alice, bob, gw);
+        env.trust (USD(1000), alice, bob);
+        env.close();
+
+        // Count the currencies of every account with a line
+        TrustLineGraph graph ((beast::Journal()), 1);
+        graph.advance (*env.closed());
+        expect (! graph.getCurrencies (gw.id(), *env.current()));
+        for (auto const& account : { gw, alice, bob })
+            expectCurrencies (graph, *env.closed(), account);
+
+        auto const before = graph.getCurrencies (gw.id(), *env.closed());
+        expect (before->source.count (USD.currency) == 1);
+        expect (before->destination.empty());
+
+        // Issue, open a line in a new currency and pay back
+        env (pay (gw, alice, USD(100)));
+        env.trust (EUR(500), bob);
+        env (pay (gw, bob, EUR(10)));
+        env.close();
+        graph.advance (*env.closed());
+        for (auto const& account : { gw, alice, bob })
+            expectCurrencies (graph, *env.closed(), account);
+
+        env (pay (alice, gw, USD(100)));
+        env (trust (alice, USD(0)));
+        env (trust (bob, USD(0)));
+        env.close();
+        graph.advance (*env.closed());
+        for (auto const& account : { gw, alice, bob })
+            expectCurrencies (graph, *env.closed(), account);
+
+        auto const after = graph.getCurrencies (gw.id(), *env.closed());
+        expect (after->source.count (USD.currency) == 0);
+        expect (after->source.count (EUR.currency) == 1);
+
+        // Accounts with few lines are left to the caller
+        TrustLineGraph cold ((beast::Journal()));
+        cold.advance (*env.closed());
+        expect (! cold.getCurrencies (gw.id(), *env.closed()));
+    }
+
+    void run() override
+    {
+        testAdvance();
+        testCurrencies();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TrustLineGraph,app,ripple);
+
+} // test
+} // ripple
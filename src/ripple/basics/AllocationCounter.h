@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_BASICS_ALLOCATIONCOUNTER_H_INCLUDED
+#define RIPPLE_BASICS_ALLOCATIONCOUNTER_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+
+namespace ripple {
+
+namespace detail {
+
+extern std::atomic<std::uint64_t> allocations;
+extern std::atomic<std::uint64_t> allocatedBytes;
+
+} // detail
+
+/** Counts calls to the global operator new since construction,
+    and the bytes they requested.
+
+    Allocations on every thread are counted. The counting operator
+    new is only compiled in with RIPPLE_COUNT_ALLOCATIONS; without
+    it enabled() returns false and the count stays at zero.
+*/
+class AllocationCounter
+{
+private:
+    std::uint64_t start_;
+    std::uint64_t startBytes_;
+
+public:
+    AllocationCounter ()
+        : start_ (detail::allocations.load ())
+        , startBytes_ (detail::allocatedBytes.load ())
+    {
+    }
+
+    static
+    bool
+    enabled ();
+
+    std::uint64_t
+    count () const
+    {
+        return detail::allocations.load () - start_;
+    }
+
+    std::uint64_t
+    bytes () const
+    {
+        return detail::allocatedBytes.load () - startBytes_;
+    }
+};
+
+} // ripple
+
+#endif
@@ -31,6 +31,8 @@
 #include <ripple/basics/hardened_hash.h>
 #include <ripple/beast/utility/Zero.h>
 #include <boost/functional/hash.hpp>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <type_traits>
 
@@ -39,6 +41,91 @@ using beast::Zero;
 
 namespace ripple {
 
+namespace detail {
+
+// Word at a time operations on the fixed size byte strings held by
+// base_uint. The loads go through memcpy, which compilers turn into
+// plain moves, and the loops have constant trip counts, so equality
+// and zero tests reduce without branches and are vectorized.
+
+template <std::size_t Bytes>
+inline
+bool
+uint_is_zero (unsigned char const* p)
+{
+    static_assert ((Bytes % 4) == 0, "");
+    std::uint64_t acc = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= Bytes; i += 8)
+    {
+        std::uint64_t w;
+        std::memcpy (&w, p + i, 8);
+        acc |= w;
+    }
+    if (i < Bytes)
+    {
+        std::uint32_t w;
+        std::memcpy (&w, p + i, 4);
+        acc |= w;
+    }
+    return acc == 0;
+}
+
+template <std::size_t Bytes>
+inline
+bool
+uint_equal (unsigned char const* a, unsigned char const* b)
+{
+    static_assert ((Bytes % 4) == 0, "");
+    std::uint64_t acc = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= Bytes; i += 8)
+    {
+        std::uint64_t wa, wb;
+        std::memcpy (&wa, a + i, 8);
+        std::memcpy (&wb, b + i, 8);
+        acc |= wa ^ wb;
+    }
+    if (i < Bytes)
+    {
+        std::uint32_t wa, wb;
+        std::memcpy (&wa, a + i, 4);
+        std::memcpy (&wb, b + i, 4);
+        acc |= wa ^ wb;
+    }
+    return acc == 0;
+}
+
+// Keys usually differ in their first word, so this finds the
+// first differing word and only then looks at bytes.
+template <std::size_t Bytes>
+inline
+int
+uint_compare (unsigned char const* a, unsigned char const* b)
+{
+    static_assert ((Bytes % 4) == 0, "");
+    std::size_t i = 0;
+    for (; i + 8 <= Bytes; i += 8)
+    {
+        std::uint64_t wa, wb;
+        std::memcpy (&wa, a + i, 8);
+        std::memcpy (&wb, b + i, 8);
+        if (wa != wb)
+            return (std::memcmp (a + i, b + i, 8) < 0) ? -1 : 1;
+    }
+    if (i < Bytes)
+    {
+        std::uint32_t wa, wb;
+        std::memcpy (&wa, a + i, 4);
+        std::memcpy (&wb, b + i, 4);
+        if (wa != wb)
+            return (std::memcmp (a + i, b + i, 4) < 0) ? -1 : 1;
+    }
+    return 0;
+}
+
+} // detail
+
 // This class stores its values internally in big-endian form
 
 template <std::size_t Bits, class Tag = void>
@@ -167,11 +254,7 @@ public:
 
     int signum() const
     {
-        for (int i = 0; i < WIDTH; i++)
-            if (pn[i] != 0)
-                return 1;
-
-        return 0;
+        return detail::uint_is_zero<bytes> (data()) ? 0 : 1;
     }
 
     bool operator! () const
@@ -318,24 +401,11 @@ public:
     */
     bool SetHexExact (const char* psz)
     {
-        unsigned char* pOut  = begin ();
-
-        for (int i = 0; i < sizeof (pn); ++i)
-        {
-            auto hi = charUnHex(*psz++);
-            if (hi == -1)
-                return false;
-
-            auto lo = charUnHex (*psz++);
-            if (lo == -1)
-                return false;
-
-            *pOut++ = (hi << 4) | lo;
-        }
+        // Anything but exactly as many characters as we need fails
+        if (std::strlen (psz) != 2 * sizeof (pn))
+            return false;
 
-        // We've consumed exactly as many bytes as we needed at this point
-        // so we should be at the end of the string.
-        return (*psz == 0);
+        return hexDecode (psz, sizeof (pn), begin ());
     }
 
     /** Parse a hex string into a base_uint
@@ -380,18 +450,9 @@ public:
         if ((pEnd - pBegin) & 1)
             *pOut++ = charUnHex(*pBegin++);
 
-        while (pBegin != pEnd)
-        {
-            auto cHigh = charUnHex(*pBegin++);
-            auto cLow  = pBegin == pEnd
-                            ? 0
-                            : charUnHex(*pBegin++);
-
-            if (cHigh == -1 || cLow == -1)
-                return false;
-
-            *pOut++ = (cHigh << 4) | cLow;
-        }
+        // Every character up to pEnd is a hex digit
+        hexDecode (reinterpret_cast<char const*> (pBegin),
+            (pEnd - pBegin) / 2, pOut);
 
         return !*pEnd;
     }
@@ -403,7 +464,10 @@ public:
 
     bool SetHexExact (std::string const& str)
     {
-        return SetHexExact (str.c_str ());
+        if (str.size () != 2 * sizeof (pn))
+            return false;
+
+        return hexDecode (str.data (), sizeof (pn), begin ());
     }
 
     unsigned int size () const
@@ -431,17 +495,7 @@ template <std::size_t Bits, class Tag>
 inline int compare (
     base_uint<Bits, Tag> const& a, base_uint<Bits, Tag> const& b)
 {
-    auto ret = std::mismatch (a.cbegin (), a.cend (), b.cbegin ());
-
-    if (ret.first == a.cend ())
-        return 0;
-
-    // a > b
-    if (*ret.first > *ret.second)
-        return 1;
-
-    // a < b
-    return -1;
+    return detail::uint_compare<Bits / 8> (a.data (), b.data ());
 }
 
 template <std::size_t Bits, class Tag>
@@ -476,14 +530,14 @@ template <std::size_t Bits, class Tag>
 inline bool operator== (
     base_uint<Bits, Tag> const& a, base_uint<Bits, Tag> const& b)
 {
-    return compare (a, b) == 0;
+    return detail::uint_equal<Bits / 8> (a.data (), b.data ());
 }
 
 template <std::size_t Bits, class Tag>
 inline bool operator!= (
     base_uint<Bits, Tag> const& a, base_uint<Bits, Tag> const& b)
 {
-    return compare (a, b) != 0;
+    return !(a == b);
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/basics/AllocationCounter.h>
+#include <cstdlib>
+#include <new>
+
+namespace ripple {
+
+namespace detail {
+
+std::atomic<std::uint64_t> allocations {0};
+std::atomic<std::uint64_t> allocatedBytes {0};
+
+} // detail
+
+bool
+AllocationCounter::enabled ()
+{
+#if RIPPLE_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // ripple
+
+#if RIPPLE_COUNT_ALLOCATIONS
+
+void*
+operator new (std::size_t size)
+{
+    ripple::detail::allocations.fetch_add (
+        1, std::memory_order_relaxed);
+    ripple::detail::allocatedBytes.fetch_add (
+        size, std::memory_order_relaxed);
+    if (auto const p = std::malloc (size ? size : 1))
+        return p;
+    throw std::bad_alloc ();
+}
+
+void*
+operator new[] (std::size_t size)
+{
+    return operator new (size);
+}
+
+void*
+operator new (std::size_t size, std::nothrow_t const&) noexcept
+{
+    ripple::detail::allocations.fetch_add (
+        1, std::memory_order_relaxed);
+    ripple::detail::allocatedBytes.fetch_add (
+        size, std::memory_order_relaxed);
+    return std::malloc (size ? size : 1);
+}
+
+void*
+operator new[] (std::size_t size, std::nothrow_t const& tag) noexcept
+{
+    return operator new (size, tag);
+}
+
+void
+operator delete (void* p) noexcept
+{
+    std::free (p);
+}
+
+void
+operator delete[] (void* p) noexcept
+{
+    std::free (p);
+}
+
+void
+operator delete (void* p, std::nothrow_t const&) noexcept
+{
+    std::free (p);
+}
+
+void
+operator delete[] (void* p, std::nothrow_t const&) noexcept
+{
+    std::free (p);
+}
+
+#endif
@@ -21,6 +21,15 @@
 #include <ripple/basics/Slice.h>
 #include <ripple/basics/strHex.h>
 #include <algorithm>
+#include <cstdint>
+
+// SSE2 is part of every x86-64 processor
+#if defined(__SSE2__) || defined(_M_X64)
+#define RIPPLE_STRHEX_SSE2 1
+#include <emmintrin.h>
+#else
+#define RIPPLE_STRHEX_SSE2 0
+#endif
 
 namespace ripple {
 
@@ -52,6 +61,116 @@ int charUnHex (unsigned char c)
     return xtab[c];
 }
 
+#if RIPPLE_STRHEX_SSE2
+
+// Turns sixteen nibbles into the characters '0'-'9' and 'A'-'F'
+static inline
+__m128i
+nibblesToHex (__m128i v)
+{
+    auto const letters = _mm_and_si128 (
+        _mm_cmpgt_epi8 (v, _mm_set1_epi8 (9)), _mm_set1_epi8 ('A' - '0' - 10));
+    return _mm_add_epi8 (_mm_add_epi8 (v, _mm_set1_epi8 ('0')), letters);
+}
+
+// Turns sixteen hex digits into their values, clearing valid
+// to zero in each position that is not a hex digit
+static inline
+__m128i
+hexToNibbles (__m128i c, __m128i& valid)
+{
+    // Unsigned less-than, done as a signed compare with the sign flipped
+    auto const flip = _mm_set1_epi8 (-128);
+    auto const below = [&](__m128i x, char n)
+    {
+        return _mm_cmplt_epi8 (_mm_xor_si128 (x, flip),
+            _mm_set1_epi8 (static_cast<char> (n ^ -128)));
+    };
+
+    auto const digit = _mm_sub_epi8 (c, _mm_set1_epi8 ('0'));
+    auto const letter = _mm_sub_epi8 (
+        _mm_or_si128 (c, _mm_set1_epi8 (0x20)), _mm_set1_epi8 ('a'));
+    auto const isDigit = below (digit, 10);
+    auto const isLetter = below (letter, 6);
+
+    valid = _mm_and_si128 (valid, _mm_or_si128 (isDigit, isLetter));
+    return _mm_or_si128 (
+        _mm_and_si128 (isDigit, digit),
+        _mm_and_si128 (isLetter, _mm_add_epi8 (letter, _mm_set1_epi8 (10))));
+}
+
+// Combines pairs of nibbles, high first, into eight bytes
+// held in the low half of each 16-bit lane
+static inline
+__m128i
+packNibbles (__m128i v)
+{
+    auto const mask = _mm_set1_epi16 (0x00ff);
+    return _mm_or_si128 (
+        _mm_slli_epi16 (_mm_and_si128 (v, mask), 4),
+        _mm_srli_epi16 (v, 8));
+}
+
+#endif
+
+void
+hexEncode (void const* data, std::size_t size, char* out)
+{
+    auto p = static_cast<unsigned char const*> (data);
+
+#if RIPPLE_STRHEX_SSE2
+    auto const mask = _mm_set1_epi8 (0x0f);
+    for (; size >= 16; size -= 16, p += 16, out += 32)
+    {
+        auto const v = _mm_loadu_si128 (reinterpret_cast<__m128i const*> (p));
+        auto const hi = _mm_and_si128 (_mm_srli_epi16 (v, 4), mask);
+        auto const lo = _mm_and_si128 (v, mask);
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (out),
+            nibblesToHex (_mm_unpacklo_epi8 (hi, lo)));
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (out + 16),
+            nibblesToHex (_mm_unpackhi_epi8 (hi, lo)));
+    }
+#endif
+
+    for (; size != 0; --size)
+    {
+        unsigned char const c = *p++;
+        *out++ = charHex (c >> 4);
+        *out++ = charHex (c & 15);
+    }
+}
+
+bool
+hexDecode (char const* in, std::size_t size, void* out)
+{
+    auto p = static_cast<unsigned char*> (out);
+
+#if RIPPLE_STRHEX_SSE2
+    for (; size >= 16; size -= 16, in += 32, p += 16)
+    {
+        auto valid = _mm_set1_epi8 (-1);
+        auto const a = hexToNibbles (_mm_loadu_si128 (
+            reinterpret_cast<__m128i const*> (in)), valid);
+        auto const b = hexToNibbles (_mm_loadu_si128 (
+            reinterpret_cast<__m128i const*> (in + 16)), valid);
+        if (_mm_movemask_epi8 (valid) != 0xffff)
+            return false;
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (p),
+            _mm_packus_epi16 (packNibbles (a), packNibbles (b)));
+    }
+#endif
+
+    for (; size != 0; --size)
+    {
+        auto const hi = charUnHex (*in++);
+        auto const lo = charUnHex (*in++);
+        if (hi == -1 || lo == -1)
+            return false;
+        *p++ = static_cast<unsigned char> ((hi << 4) | lo);
+    }
+    return true;
+}
+
 std::string
 strHex(Slice const& slice)
 {
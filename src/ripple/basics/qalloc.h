@@ -22,6 +22,7 @@
 
 #include <ripple/basics/contract.h>
 #include <boost/intrusive/list.hpp>
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -65,6 +66,8 @@ private:
 
     block* used_ = nullptr;
     block* free_ = nullptr;
+    std::size_t first_;
+    std::size_t next_;
 
 public:
     enum
@@ -72,12 +75,26 @@ public:
         block_size = 256 * 1024
     };
 
-    qalloc_impl() = default;
+    /** Create an arena.
+
+        Each new block is twice the size of the one before it, starting
+        at first_block and up to block_size, so that an arena which only
+        ever holds a few objects does not pay for a full block.
+    */
+    explicit
+    qalloc_impl (std::size_t first_block = block_size);
+
     qalloc_impl (qalloc_impl const&) = delete;
     qalloc_impl& operator= (qalloc_impl const&) = delete;
 
     ~qalloc_impl();
 
+    std::size_t
+    first_block() const
+    {
+        return first_;
+    }
+
     void*
     allocate (std::size_t bytes, std::size_t align);
 
@@ -121,6 +138,14 @@ public:
 
     qalloc_type();
 
+    /** Create an allocator with its own arena.
+
+        @param first_block The size of the first block the arena
+                           allocates. Later blocks double in size.
+    */
+    explicit
+    qalloc_type (std::size_t first_block);
+
     template <class U>
     qalloc_type (qalloc_type<U, ShareOnCopy> const& u);
 
@@ -226,19 +251,26 @@ qalloc_impl<_>::block::deallocate()
     return true;
 }
 
+template <class _>
+qalloc_impl<_>::qalloc_impl (std::size_t first_block)
+    : first_ (std::min<std::size_t>(first_block, block_size))
+    , next_ (first_)
+{
+}
+
 template <class _>
 qalloc_impl<_>::~qalloc_impl()
 {
     if (used_)
     {
         used_->~block();
-        std::free(used_);
+        ::operator delete(used_);
     }
     while (free_)
     {
         auto const next = free_->next;
         free_->~block();
-        std::free(free_);
+        ::operator delete(free_);
         free_ = next;
     }
 }
@@ -272,11 +304,10 @@ qalloc_impl<_>::allocate(
     std::size_t const min_alloc =  // align up
         ((sizeof (block) + sizeof (block*) + bytes) + (adj_align - 1)) &
         ~(adj_align - 1);
-    auto const n = std::max<std::size_t>(block_size, min_alloc);
+    auto const n = std::max<std::size_t>(next_, min_alloc);
+    next_ = std::min<std::size_t>(next_ * 2, block_size);
     block* const b =
-        new(std::malloc(n)) block(n);
-    if (! b)
-        Throw<std::bad_alloc> ();
+        new(::operator new(n)) block(n);
     used_ = b;
     // VFALCO This has to succeed
     return used_->allocate(bytes, align);
@@ -308,6 +339,13 @@ qalloc_type<T, ShareOnCopy>::qalloc_type()
 {
 }
 
+template <class T, bool ShareOnCopy>
+qalloc_type<T, ShareOnCopy>::qalloc_type (std::size_t first_block)
+    : impl_ (std::make_shared<
+        detail::qalloc_impl<>>(first_block))
+{
+}
+
 template <class T, bool ShareOnCopy>
 template <class U>
 qalloc_type<T, ShareOnCopy>::qalloc_type(
@@ -398,7 +436,7 @@ auto
 qalloc_type<T, ShareOnCopy>::select_on_copy(std::false_type) const ->
     qalloc_type
 {
-    return {}; // new arena
+    return qalloc_type(impl_->first_block()); // new arena
 }
 
 } // ripple
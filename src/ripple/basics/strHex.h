@@ -26,7 +26,9 @@
 #define RIPPLE_BASICS_STRHEX_H_INCLUDED
 
 #include <cassert>
+#include <cstddef>
 #include <string>
+#include <type_traits>
 
 namespace ripple {
 
@@ -62,19 +64,54 @@ charUnHex (char c)
 }
 /** @} */
 
+/** Writes the upper case hex form of a buffer.
+    @param out receives exactly 2 * size characters.
+*/
+void
+hexEncode (void const* data, std::size_t size, char* out);
+
+/** Reads 2 * size hex digits into a buffer of size bytes.
+    @return `false` if any character is not a hex digit.
+*/
+bool
+hexDecode (char const* in, std::size_t size, void* out);
+
+namespace detail {
+
+template<class FwdIt>
+void
+strHex (FwdIt first, int size, char* out, std::false_type)
+{
+    for (int i = 0; i < size; i++)
+    {
+        unsigned char c = *first++;
+        out[i * 2]     = charHex (c >> 4);
+        out[i * 2 + 1] = charHex (c & 15);
+    }
+}
+
+template<class T>
+void
+strHex (T const* first, int size, char* out, std::true_type)
+{
+    hexEncode (first, size, out);
+}
+
+} // detail
+
 // NIKB TODO cleanup this function and reduce the need for the many overloads
 //           it has in various places.
 template<class FwdIt>
 std::string strHex (FwdIt first, int size)
 {
+    // Contiguous bytes are converted in bulk
+    using bytes = std::integral_constant<bool,
+        std::is_pointer<FwdIt>::value && sizeof (*first) == 1>;
+
     std::string s;
     s.resize (size * 2);
-    for (int i = 0; i < size; i++)
-    {
-        unsigned char c = *first++;
-        s[i * 2]     = charHex (c >> 4);
-        s[i * 2 + 1] = charHex (c & 15);
-    }
+    if (size > 0)
+        detail::strHex (first, size, &s[0], bytes{});
     return s;
 }
 
@@ -0,0 +1,269 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+namespace detail {
+
+template <class T>
+T
+randomUint (beast::xor_shift_engine& engine)
+{
+    T v;
+    for (auto& b : v)
+        b = std::uniform_int_distribution<int>(0, 255)(engine);
+    return v;
+}
+
+// Byte by byte, as base_uint used to compare
+template <class T>
+int
+refCompare (T const& a, T const& b)
+{
+    auto const ret = std::mismatch (a.cbegin (), a.cend (), b.cbegin ());
+    if (ret.first == a.cend ())
+        return 0;
+    return (*ret.first > *ret.second) ? 1 : -1;
+}
+
+} // detail
+
+class base_uint_test : public beast::unit_test::suite
+{
+public:
+    template <class T>
+    void
+    testCompare ()
+    {
+        beast::xor_shift_engine engine;
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto const a = detail::randomUint<T> (engine);
+            auto b = a;
+            expect (compare (a, b) == 0);
+            expect (a == b);
+            expect (! (a != b));
+
+            // Differ in a single byte at each position
+            auto const pos = i % T::bytes;
+            b.begin()[pos] ^= 1 << (i % 8);
+            expect (compare (a, b) == detail::refCompare (a, b));
+            expect (compare (b, a) == detail::refCompare (b, a));
+            expect (a != b);
+            expect ((a < b) == (detail::refCompare (a, b) < 0));
+
+            auto const c = detail::randomUint<T> (engine);
+            expect (compare (a, c) == detail::refCompare (a, c));
+        }
+    }
+
+    template <class T>
+    void
+    testZero ()
+    {
+        T v;
+        expect (v.isZero ());
+        expect (v.signum () == 0);
+        expect (v == zero);
+        for (std::size_t i = 0; i < T::bytes; ++i)
+        {
+            T w;
+            w.begin()[i] = 0x80;
+            expect (w.isNonZero ());
+            expect (w.signum () == 1);
+        }
+    }
+
+    template <class T>
+    void
+    testHex ()
+    {
+        beast::xor_shift_engine engine;
+        for (int i = 0; i < 100; ++i)
+        {
+            auto const v = detail::randomUint<T> (engine);
+            auto const text = to_string (v);
+            expect (text.size () == 2 * T::bytes);
+
+            std::string ref;
+            for (auto c : v)
+            {
+                ref += charHex (c >> 4);
+                ref += charHex (c & 15);
+            }
+            expect (text == ref);
+
+            T exact;
+            expect (exact.SetHexExact (text));
+            expect (exact == v);
+
+            std::string lower (text);
+            std::transform (lower.begin (), lower.end (), lower.begin (),
+                [](char c) { return std::tolower (c); });
+            T loose;
+            expect (loose.SetHex (lower));
+            expect (loose == v);
+
+            // Every bad character position is caught
+            auto bad = text;
+            bad[i % bad.size ()] = 'G';
+            expect (! exact.SetHexExact (bad));
+        }
+
+        T v;
+        expect (! v.SetHexExact (std::string (2 * T::bytes - 1, 'A')));
+        expect (! v.SetHexExact (std::string (2 * T::bytes + 1, 'A')));
+        expect (v.SetHex ("0x123"));
+        expect (v == T (0x123));
+    }
+
+    template <class T>
+    void
+    testType (char const* name)
+    {
+        testcase (name);
+        testCompare<T> ();
+        testZero<T> ();
+        testHex<T> ();
+    }
+
+    void
+    run () override
+    {
+        testType<uint128> ("uint128");
+        testType<uint160> ("uint160");
+        testType<uint256> ("uint256");
+    }
+};
+
+// Compares throughput against byte at a time implementations
+class base_uint_timing_test : public beast::unit_test::suite
+{
+public:
+    template <class F>
+    std::chrono::duration<double>
+    timed (F&& f)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::steady_clock::now() - start;
+    }
+
+    void
+    run () override
+    {
+        using namespace std::chrono;
+        int const n = 5000000;
+        beast::xor_shift_engine engine;
+        std::vector<uint256> keys;
+        for (int i = 0; i < 1024; ++i)
+        {
+            // Shared prefixes, as with keys in one directory
+            auto key = detail::randomUint<uint256> (engine);
+            std::fill (key.begin (), key.begin () + (i % 24), 0);
+            keys.push_back (key);
+        }
+
+        std::size_t sink = 0;
+        auto const fast = timed ([&]
+        {
+            for (int i = 0; i < n; ++i)
+                sink += compare (keys[i & 1023], keys[(i * 7) & 1023]) < 0;
+        });
+        auto const ref = timed ([&]
+        {
+            for (int i = 0; i < n; ++i)
+                sink += detail::refCompare (
+                    keys[i & 1023], keys[(i * 7) & 1023]) < 0;
+        });
+        log << "compare: " << duration_cast<milliseconds>(fast).count() <<
+            "ms, bytewise: " << duration_cast<milliseconds>(ref).count() <<
+            "ms";
+
+        int const m = n / 10;
+        auto const encode = timed ([&]
+        {
+            for (int i = 0; i < m; ++i)
+                sink += to_string (keys[i & 1023]).size ();
+        });
+        auto const encodeRef = timed ([&]
+        {
+            for (int i = 0; i < m; ++i)
+            {
+                std::string s (64, 0);
+                auto const& key = keys[i & 1023];
+                for (int j = 0; j < 32; ++j)
+                {
+                    s[2 * j] = charHex (key.begin()[j] >> 4);
+                    s[2 * j + 1] = charHex (key.begin()[j] & 15);
+                }
+                sink += s.size ();
+            }
+        });
+        log << "to_string: " << duration_cast<milliseconds>(encode).count() <<
+            "ms, bytewise: " << duration_cast<milliseconds>(encodeRef).count() <<
+            "ms";
+
+        std::vector<std::string> text;
+        for (auto const& key : keys)
+            text.push_back (to_string (key));
+        auto const decode = timed ([&]
+        {
+            uint256 v;
+            for (int i = 0; i < m; ++i)
+                sink += v.SetHexExact (text[i & 1023]);
+        });
+        auto const decodeRef = timed ([&]
+        {
+            uint256 v;
+            for (int i = 0; i < m; ++i)
+            {
+                auto p = text[i & 1023].c_str ();
+                for (auto& b : v)
+                {
+                    b = (charUnHex (p[0]) << 4) | charUnHex (p[1]);
+                    p += 2;
+                }
+                sink += v.signum ();
+            }
+        });
+        log << "SetHexExact: " << duration_cast<milliseconds>(decode).count() <<
+            "ms, bytewise: " << duration_cast<milliseconds>(decodeRef).count() <<
+            "ms";
+        pass ();
+        expect (sink != 0);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(base_uint,basics,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(base_uint_timing,basics,ripple);
+
+} // test
+} // ripple
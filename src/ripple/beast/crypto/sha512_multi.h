@@ -0,0 +1,371 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of Beast: https://github.com/vinniefalco/Beast
+    Copyright 2016, Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef BEAST_CRYPTO_SHA512_MULTI_H_INCLUDED
+#define BEAST_CRYPTO_SHA512_MULTI_H_INCLUDED
+
+#include <ripple/beast/crypto/detail/sha2_context.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// The SIMD kernels rely on GCC/Clang vector extensions and
+// per-function target attributes, with a runtime CPU check.
+#ifndef BEAST_SHA512_MULTI_SIMD
+# if defined(__GNUC__) && defined(__x86_64__)
+#  define BEAST_SHA512_MULTI_SIMD 1
+# else
+#  define BEAST_SHA512_MULTI_SIMD 0
+# endif
+#endif
+
+namespace beast {
+
+/** A message for sha512_multi.
+
+    The message is the concatenation of up to three buffers, so
+    that a prefix and a suffix can be hashed along with the body
+    without copying. The buffers must outlive the call.
+*/
+struct sha512_message
+{
+    static std::size_t const max_parts = 3;
+
+    std::array<void const*, max_parts> data;
+    std::array<std::size_t, max_parts> size;
+    std::size_t parts = 0;
+
+    sha512_message() = default;
+
+    sha512_message (void const* p, std::size_t n)
+    {
+        append (p, n);
+    }
+
+    void
+    append (void const* p, std::size_t n)
+    {
+        assert (parts < max_parts);
+        data[parts] = p;
+        size[parts++] = n;
+    }
+
+    std::size_t
+    length() const
+    {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < parts; ++i)
+            n += size[i];
+        return n;
+    }
+};
+
+using sha512_digest = std::array<std::uint8_t, 64>;
+
+namespace detail {
+
+// Produces the padded 128 byte blocks of one message
+class sha512_lane
+{
+private:
+    sha512_message const* m_;
+    std::size_t part_;
+    std::size_t offset_;
+    std::uint64_t length_;
+    std::size_t blocks_;
+    std::size_t block_;
+    bool padded_;
+
+public:
+    void
+    reset (sha512_message const& m)
+    {
+        m_ = &m;
+        part_ = 0;
+        offset_ = 0;
+        length_ = m.length();
+        // Room for the 0x80 byte and the 128-bit length
+        blocks_ = (length_ + 17 + 127) / 128;
+        block_ = 0;
+        padded_ = false;
+    }
+
+    std::size_t
+    blocks() const
+    {
+        return blocks_;
+    }
+
+    void
+    next (unsigned char* out)
+    {
+        std::size_t filled = 0;
+        while (filled < 128 && part_ < m_->parts)
+        {
+            auto const n = std::min (128 - filled,
+                m_->size[part_] - offset_);
+            std::memcpy (out + filled, reinterpret_cast<
+                unsigned char const*>(m_->data[part_]) + offset_, n);
+            filled += n;
+            offset_ += n;
+            if (offset_ == m_->size[part_])
+            {
+                ++part_;
+                offset_ = 0;
+            }
+        }
+        if (filled < 128)
+        {
+            std::memset (out + filled, 0, 128 - filled);
+            if (! padded_)
+            {
+                out[filled] = 0x80;
+                padded_ = true;
+            }
+            if (block_ == blocks_ - 1)
+            {
+                std::uint64_t const hi = length_ >> 61;
+                std::uint64_t const lo = length_ << 3;
+                BEAST_SHA2_UNPACK64(hi, out + 112);
+                BEAST_SHA2_UNPACK64(lo, out + 120);
+            }
+        }
+        ++block_;
+    }
+};
+
+template <class = void>
+void
+sha512_multi_scalar (sha512_message const* messages,
+    std::size_t count, sha512_digest* digests) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sha512_context ctx;
+        init (ctx);
+        for (std::size_t j = 0; j < messages[i].parts; ++j)
+            update (ctx, messages[i].data[j], messages[i].size[j]);
+        finish (ctx, digests[i].data());
+    }
+}
+
+#if BEAST_SHA512_MULTI_SIMD
+
+// The scalar macros take the rotation width from sizeof,
+// which is the whole vector here rather than one lane.
+#define BEAST_SHA512M_ROTR(x, n) ((x >> n) | (x << (64 - n)))
+#define BEAST_SHA512M_F1(x) (BEAST_SHA512M_ROTR(x, 28) ^ BEAST_SHA512M_ROTR(x, 34) ^ BEAST_SHA512M_ROTR(x, 39))
+#define BEAST_SHA512M_F2(x) (BEAST_SHA512M_ROTR(x, 14) ^ BEAST_SHA512M_ROTR(x, 18) ^ BEAST_SHA512M_ROTR(x, 41))
+#define BEAST_SHA512M_F3(x) (BEAST_SHA512M_ROTR(x,  1) ^ BEAST_SHA512M_ROTR(x,  8) ^ (x >> 7))
+#define BEAST_SHA512M_F4(x) (BEAST_SHA512M_ROTR(x, 19) ^ BEAST_SHA512M_ROTR(x, 61) ^ (x >> 6))
+
+// Hashes up to Lanes messages side by side, one per vector lane.
+// This is always inlined into a caller compiled for the target
+// instruction set, which is what turns the generic vector code
+// into AVX2 or AVX-512 instructions.
+template <std::size_t Lanes, class V>
+__attribute__((always_inline)) inline
+void
+sha512_lanes (sha512_message const* messages,
+    std::size_t count, sha512_digest* digests) noexcept
+{
+    static unsigned char const idle[128] = {};
+    auto const K = sha512_k<>::value;
+
+    sha512_lane lanes[Lanes];
+    std::size_t blocks = 0;
+    for (std::size_t l = 0; l < count; ++l)
+    {
+        lanes[l].reset (messages[l]);
+        blocks = std::max (blocks, lanes[l].blocks());
+    }
+
+    V h[8];
+    {
+        sha512_context ctx;
+        init (ctx);
+        for (int i = 0; i < 8; ++i)
+            for (std::size_t l = 0; l < Lanes; ++l)
+                h[i][l] = ctx.h[i];
+    }
+
+    unsigned char buf[Lanes][128];
+    for (std::size_t b = 0; b < blocks; ++b)
+    {
+        unsigned char const* in[Lanes];
+        bool active[Lanes];
+        bool partial = false;
+        for (std::size_t l = 0; l < Lanes; ++l)
+        {
+            active[l] = l < count && b < lanes[l].blocks();
+            if (active[l])
+            {
+                lanes[l].next (buf[l]);
+                in[l] = buf[l];
+            }
+            else
+            {
+                in[l] = idle;
+                partial = true;
+            }
+        }
+
+        V w[80];
+        for (int j = 0; j < 16; ++j)
+        {
+            for (std::size_t l = 0; l < Lanes; ++l)
+            {
+                std::uint64_t v;
+                BEAST_SHA2_PACK64(in[l] + (j << 3), &v);
+                w[j][l] = v;
+            }
+        }
+        for (int j = 16; j < 80; ++j)
+            w[j] = BEAST_SHA512M_F4(w[j - 2]) + w[j - 7] +
+                BEAST_SHA512M_F3(w[j - 15]) + w[j - 16];
+
+        V wv[8];
+        for (int j = 0; j < 8; ++j)
+            wv[j] = h[j];
+        for (int j = 0; j < 80; ++j)
+        {
+            V const t1 = wv[7] + BEAST_SHA512M_F2(wv[4]) +
+                BEAST_SHA2_CH(wv[4], wv[5], wv[6]) +
+                    static_cast<std::uint64_t>(K[j]) + w[j];
+            V const t2 = BEAST_SHA512M_F1(wv[0]) +
+                BEAST_SHA2_MAJ(wv[0], wv[1], wv[2]);
+            wv[7] = wv[6];
+            wv[6] = wv[5];
+            wv[5] = wv[4];
+            wv[4] = wv[3] + t1;
+            wv[3] = wv[2];
+            wv[2] = wv[1];
+            wv[1] = wv[0];
+            wv[0] = t1 + t2;
+        }
+
+        // Lanes without a block this round keep their state
+        if (partial)
+        {
+            for (std::size_t l = 0; l < Lanes; ++l)
+                if (! active[l])
+                    for (int j = 0; j < 8; ++j)
+                        wv[j][l] = 0;
+        }
+        for (int j = 0; j < 8; ++j)
+            h[j] += wv[j];
+    }
+
+    for (std::size_t l = 0; l < count; ++l)
+        for (int i = 0; i < 8; ++i)
+            BEAST_SHA2_UNPACK64(static_cast<std::uint64_t>(h[i][l]),
+                &digests[l][i << 3]);
+}
+
+typedef std::uint64_t sha512_v4 __attribute__((vector_size(32)));
+typedef std::uint64_t sha512_v8 __attribute__((vector_size(64)));
+
+__attribute__((target("avx2"))) inline
+void
+sha512_multi_avx2 (sha512_message const* messages,
+    std::size_t count, sha512_digest* digests) noexcept
+{
+    for (std::size_t i = 0; i < count; i += 4)
+        sha512_lanes<4, sha512_v4> (messages + i,
+            std::min<std::size_t>(4, count - i), digests + i);
+}
+
+__attribute__((target("avx512f"))) inline
+void
+sha512_multi_avx512 (sha512_message const* messages,
+    std::size_t count, sha512_digest* digests) noexcept
+{
+    for (std::size_t i = 0; i < count; i += 8)
+        sha512_lanes<8, sha512_v8> (messages + i,
+            std::min<std::size_t>(8, count - i), digests + i);
+}
+
+#undef BEAST_SHA512M_F4
+#undef BEAST_SHA512M_F3
+#undef BEAST_SHA512M_F2
+#undef BEAST_SHA512M_F1
+#undef BEAST_SHA512M_ROTR
+
+#endif
+
+} // detail
+
+/** Returns the number of messages sha512_multi hashes at once.
+
+    This is 8 with AVX-512, 4 with AVX2 and 1 otherwise.
+*/
+inline
+std::size_t
+sha512_multi_lanes()
+{
+#if BEAST_SHA512_MULTI_SIMD
+    static std::size_t const lanes = []
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports ("avx512f"))
+            return std::size_t(8);
+        if (__builtin_cpu_supports ("avx2"))
+            return std::size_t(4);
+        return std::size_t(1);
+    }();
+    return lanes;
+#else
+    return 1;
+#endif
+}
+
+/** Computes the SHA-512 digests of independent messages.
+
+    digests[i] receives the digest of messages[i]. Messages are
+    hashed in groups using the widest vector unit the processor
+    supports. Messages of similar length make the best use of
+    the lanes.
+*/
+inline
+void
+sha512_multi (sha512_message const* messages,
+    std::size_t count, sha512_digest* digests) noexcept
+{
+#if BEAST_SHA512_MULTI_SIMD
+    switch (sha512_multi_lanes())
+    {
+    case 8:
+        detail::sha512_multi_avx512 (messages, count, digests);
+        return;
+    case 4:
+        detail::sha512_multi_avx2 (messages, count, digests);
+        return;
+    default:
+        break;
+    }
+#endif
+    detail::sha512_multi_scalar (messages, count, digests);
+}
+
+} // beast
+
+#endif
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of Beast: https://github.com/vinniefalco/Beast
+    Copyright 2016, Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/crypto/sha512_multi.h>
+#include <ripple/beast/crypto/sha2.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace beast {
+
+class sha512_multi_test : public beast::unit_test::suite
+{
+public:
+    using hash_fn = void (*)(sha512_message const*,
+        std::size_t, sha512_digest*);
+
+    static
+    sha512_digest
+    reference (void const* data, std::size_t size)
+    {
+        sha512_hasher h;
+        h (data, size);
+        return static_cast<sha512_digest>(h);
+    }
+
+    void
+    check (char const* name, hash_fn hash)
+    {
+        testcase (name);
+
+        xor_shift_engine g (1234);
+        std::vector<std::uint8_t> data (2048);
+        for (auto& c : data)
+            c = std::uniform_int_distribution<int>(0, 255)(g);
+
+        std::size_t failures = 0;
+        for (int round = 0; round < 200; ++round)
+        {
+            auto const count = std::uniform_int_distribution<
+                std::size_t>(1, 19)(g);
+            std::vector<sha512_message> messages (count);
+            std::vector<std::pair<std::size_t, std::size_t>> spans;
+            for (auto& m : messages)
+            {
+                // Lengths around the padding boundaries are the
+                // interesting ones, mixed in with arbitrary sizes.
+                auto size = std::uniform_int_distribution<
+                    std::size_t>(0, 600)(g);
+                if (round % 2)
+                    size = 111 + std::uniform_int_distribution<
+                        std::size_t>(0, 3)(g) * 128 + (round % 4);
+                auto const offset = std::uniform_int_distribution<
+                    std::size_t>(0, data.size() - size)(g);
+                spans.emplace_back (offset, size);
+
+                // Split into as many as three pieces
+                auto const a = std::uniform_int_distribution<
+                    std::size_t>(0, size)(g);
+                auto const b = std::uniform_int_distribution<
+                    std::size_t>(a, size)(g);
+                m.append (&data[offset], a);
+                m.append (data.data() + offset + a, b - a);
+                m.append (data.data() + offset + b, size - b);
+            }
+
+            std::vector<sha512_digest> digests (count);
+            hash (messages.data(), count, digests.data());
+            for (std::size_t i = 0; i < count; ++i)
+                if (digests[i] != reference (
+                        &data[spans[i].first], spans[i].second))
+                    ++failures;
+        }
+        expect (failures == 0, std::to_string (failures) + " mismatches");
+    }
+
+    void
+    run() override
+    {
+        check ("dispatch", &sha512_multi);
+        check ("scalar", &detail::sha512_multi_scalar<>);
+#if BEAST_SHA512_MULTI_SIMD
+        if (sha512_multi_lanes() >= 4)
+            check ("avx2", &detail::sha512_multi_avx2);
+        if (sha512_multi_lanes() >= 8)
+            check ("avx512", &detail::sha512_multi_avx512);
+#endif
+    }
+};
+
+// Measures throughput for SHAMap inner node sized messages
+class sha512_multi_speed_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    template <class F>
+    double
+    rate (std::size_t count, std::size_t size, F&& f)
+    {
+        using namespace std::chrono;
+        auto const start = clock_type::now();
+        f();
+        auto const elapsed = duration_cast<duration<double>>(
+            clock_type::now() - start);
+        return count * size / elapsed.count() / (1024 * 1024);
+    }
+
+    void
+    run() override
+    {
+        std::size_t const count = 100000;
+        std::size_t const size = 516;
+        std::vector<std::uint8_t> data (count * size);
+        xor_shift_engine g;
+        for (auto& c : data)
+            c = static_cast<std::uint8_t>(g());
+
+        std::vector<sha512_message> messages;
+        for (std::size_t i = 0; i < count; ++i)
+            messages.emplace_back (&data[i * size], size);
+        std::vector<sha512_digest> digests (count);
+
+        auto const one = rate (count, size, [&]
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                detail::sha512_multi_scalar (
+                    &messages[i], 1, &digests[i]);
+        });
+        auto const many = rate (count, size, [&]
+        {
+            sha512_multi (messages.data(), count, digests.data());
+        });
+        log << "lanes: " << sha512_multi_lanes() <<
+            ", one at a time: " << static_cast<int>(one) << " MB/s" <<
+            ", multi: " << static_cast<int>(many) << " MB/s";
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(sha512_multi,crypto,beast);
+BEAST_DEFINE_TESTSUITE_MANUAL(sha512_multi_speed,crypto,beast);
+
+} // beast
@@ -27,3 +27,4 @@
 
 #include <ripple/beast/hash/tests/hash_append_test.cpp>
 #include <ripple/beast/hash/tests/hash_speed_test.cpp>
+#include <ripple/beast/crypto/tests/sha512_multi_test.cpp>
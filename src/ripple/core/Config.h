@@ -154,6 +154,8 @@ public:
     int                         PATH_SEARCH = 7;
     int                         PATH_SEARCH_FAST = 2;
     int                         PATH_SEARCH_MAX = 10;
+    int                         PATH_SEARCH_TIME = 2000; // milliseconds
+    int                         PATH_SEARCH_JOBS = 0; // 0 picks from the cores
 
     // Validation
     PublicKey                   VALIDATION_PUB;
@@ -172,6 +174,9 @@ public:
     std::uint32_t                      FETCH_DEPTH = 1000000000;
     int                         NODE_SIZE = 0;
 
+    // Transaction application
+    std::size_t                 APPLY_THREADS = 0;      // Threads used to build closed ledgers, 0 or 1 for serial
+
     bool                        SSL_VERIFY = true;
     std::string                 SSL_VERIFY_FILE;
     std::string                 SSL_VERIFY_DIR;
@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_CORE_PARALLELFOR_H_INCLUDED
+#define RIPPLE_CORE_PARALLELFOR_H_INCLUDED
+
+#include <ripple/core/JobQueue.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+
+namespace detail {
+
+class ParallelFor
+{
+private:
+    std::size_t const n_;
+    std::function<void(std::size_t)> const& f_;
+    std::atomic<std::size_t> next_ {0};
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    int running_ = 0;
+    std::exception_ptr error_;
+
+public:
+    ParallelFor (std::size_t n, std::function<void(std::size_t)> const& f)
+        : n_ (n)
+        , f_ (f)
+    {
+    }
+
+    // Called by the jobs. A job that starts after the
+    // work is gone returns without touching the function.
+    void
+    help ()
+    {
+        {
+            std::lock_guard<std::mutex> sl (mutex_);
+            ++running_;
+        }
+        run ();
+        {
+            std::lock_guard<std::mutex> sl (mutex_);
+            --running_;
+        }
+        cond_.notify_all ();
+    }
+
+    // Called by the thread that owns the work
+    void
+    finish ()
+    {
+        run ();
+        std::unique_lock<std::mutex> sl (mutex_);
+        cond_.wait (sl, [this]{ return running_ == 0; });
+        if (error_)
+            std::rethrow_exception (error_);
+    }
+
+private:
+    void
+    run ()
+    {
+        try
+        {
+            for (std::size_t i; (i = next_++) < n_;)
+                f_ (i);
+        }
+        catch (...)
+        {
+            next_ = n_;
+            std::lock_guard<std::mutex> sl (mutex_);
+            if (! error_)
+                error_ = std::current_exception ();
+        }
+    }
+};
+
+} // detail
+
+/** Call f(i) for every i in [0, n), spread over several jobs.
+
+    At most maxJobs - 1 jobs are added to the queue. The calling
+    thread works through the indexes too, so it never waits on a
+    job that has not started and this may be called from a job.
+    It returns when every call has returned. If a call throws,
+    the remaining indexes are skipped and the first exception is
+    rethrown.
+
+    The order of the calls is unspecified; callers that need a
+    deterministic result should write to a slot per index.
+*/
+template <class F>
+void
+parallelFor (JobQueue& jobQueue, JobType type, std::string const& name,
+    std::size_t n, std::size_t maxJobs, F&& f)
+{
+    auto const helpers = std::min (maxJobs, n);
+    if (helpers <= 1)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            f (i);
+        return;
+    }
+
+    std::function<void(std::size_t)> const fn (std::ref (f));
+    auto const work = std::make_shared<detail::ParallelFor> (n, fn);
+
+    for (std::size_t i = 1; i < helpers; ++i)
+        jobQueue.addJob (type, name, [work](Job&) { work->help (); });
+
+    work->finish ();
+}
+
+} // ripple
+
+#endif
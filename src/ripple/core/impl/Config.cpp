@@ -347,6 +347,9 @@ void Config::loadFromString (std::string const& fileContents)
         }
     }
 
+    if (getSingleSection (secConfig, SECTION_APPLY_THREADS, strTemp, j_))
+        APPLY_THREADS = beast::lexicalCastThrow <std::size_t> (strTemp);
+
     if (getSingleSection (secConfig, SECTION_ELB_SUPPORT, strTemp, j_))
         ELB_SUPPORT         = beast::lexicalCastThrow <bool> (strTemp);
 
@@ -425,6 +428,10 @@ void Config::loadFromString (std::string const& fileContents)
         PATH_SEARCH_FAST    = beast::lexicalCastThrow <int> (strTemp);
     if (getSingleSection (secConfig, SECTION_PATH_SEARCH_MAX, strTemp, j_))
         PATH_SEARCH_MAX     = beast::lexicalCastThrow <int> (strTemp);
+    if (getSingleSection (secConfig, SECTION_PATH_SEARCH_TIME, strTemp, j_))
+        PATH_SEARCH_TIME    = beast::lexicalCastThrow <int> (strTemp);
+    if (getSingleSection (secConfig, SECTION_PATH_SEARCH_JOBS, strTemp, j_))
+        PATH_SEARCH_JOBS    = beast::lexicalCastThrow <int> (strTemp);
 
     // If a file was explicitly specified, then warn if the
     // path is malformed or if the file does not exist or is
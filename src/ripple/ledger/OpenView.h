@@ -66,6 +66,7 @@ private:
     ReadView const* base_;
     detail::RawStateTable items_;
     std::shared_ptr<void const> hold_;
+    std::size_t baseTxCount_ = 0;
     bool open_ = true;
 
 public:
@@ -135,6 +136,21 @@ public:
     OpenView (ReadView const* base,
         std::shared_ptr<void const> hold = nullptr);
 
+    /** Construct a view that continues a sequence of tx.
+
+        Effects:
+
+            Same as the constructor above, except that
+            the first tx inserted into this view is given
+            the apply ordinal `baseTxCount`.
+
+        This allows changes buffered here to be applied
+        to another view holding `baseTxCount` tx, with
+        the same metadata as if they were made there.
+    */
+    OpenView (ReadView const* base,
+        std::size_t baseTxCount);
+
     /** Returns true if this reflects an open ledger. */
     bool
     open() const override
@@ -142,7 +158,8 @@ public:
         return open_;
     }
 
-    /** Return the number of tx inserted since creation.
+    /** Return the number of tx inserted since creation,
+        plus the base tx count given on construction.
 
         This is used to set the "apply ordinal"
         when calculating transaction metadata.
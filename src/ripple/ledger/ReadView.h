@@ -113,6 +113,10 @@ struct LedgerInfo
 
 class DigestAwareReadView;
 
+namespace detail {
+class FundsCache;
+}
+
 /** Rules controlling protocol behavior. */
 class Rules
 {
@@ -314,6 +318,15 @@ public:
         return amount;
     }
 
+    // Called to remember funds and freeze state read from the view
+    // Views that can't tell when their entries change return nullptr
+    virtual
+    detail::FundsCache*
+    fundsCache () const
+    {
+        return nullptr;
+    }
+
     // used by the implementation
     virtual
     std::unique_ptr<sles_type::iter_base>
@@ -26,7 +26,9 @@
 #include <ripple/ledger/TxMeta.h>
 #include <ripple/protocol/TER.h>
 #include <ripple/protocol/XRPAmount.h>
+#include <ripple/basics/qalloc.h>
 #include <ripple/beast/utility/Journal.h>
+#include <map>
 #include <memory>
 
 namespace ripple {
@@ -47,14 +49,27 @@ private:
         modify,
     };
 
+    // Entries live for the duration of a single apply
+    // and are released together, so an arena is cheaper
+    // than the general purpose heap. Most tables belong to
+    // short-lived sandboxes holding a handful of entries,
+    // so the arena starts small and grows as needed.
     using items_t = std::map<key_type,
-        std::pair<Action, std::shared_ptr<SLE>>>;
+        std::pair<Action, std::shared_ptr<SLE>>,
+        std::less<key_type>, qalloc_type<std::pair<key_type const,
+        std::pair<Action, std::shared_ptr<SLE>>>, false>>;
+
+    static std::size_t constexpr firstBlock = 1024;
 
     items_t items_;
     XRPAmount dropsDestroyed_ = 0;
 
 public:
-    ApplyStateTable() = default;
+    ApplyStateTable()
+        : items_ (items_t::allocator_type (firstBlock))
+    {
+    }
+
     ApplyStateTable (ApplyStateTable&&) = default;
 
     ApplyStateTable (ApplyStateTable const&) = delete;
@@ -24,6 +24,7 @@
 #include <ripple/ledger/OpenView.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/ledger/detail/ApplyStateTable.h>
+#include <ripple/ledger/detail/FundsCache.h>
 #include <ripple/protocol/XRPAmount.h>
 
 namespace ripple {
@@ -89,6 +90,9 @@ public:
     tx_type
     txRead (key_type const& key) const override;
 
+    detail::FundsCache*
+    fundsCache () const override;
+
     // ApplyView
 
     ApplyFlags
@@ -131,6 +135,7 @@ protected:
     ApplyFlags flags_;
     ReadView const* base_;
     detail::ApplyStateTable items_;
+    mutable detail::FundsCache funds_;
     XRPAmount dropsDestroyed_ = 0;
 };
 
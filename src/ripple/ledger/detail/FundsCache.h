@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_LEDGER_FUNDSCACHE_H_INCLUDED
+#define RIPPLE_LEDGER_FUNDSCACHE_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/UintTypes.h>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace ripple {
+namespace detail {
+
+/** Funds and freeze state derived from the entries of a view.
+
+    Each value remembers the keys of the ledger entries it was read
+    from, and is dropped when the view writes one of them. A cache
+    belonging to a view over another view also finds its parent's
+    values, unless this view has written their entries since.
+
+    Like the views using it, it is not safe to use from several
+    threads at once.
+*/
+class FundsCache
+{
+public:
+    enum class Kind : std::uint8_t
+    {
+        holds,          // Balance, ignoring freezes
+        holdsUnfrozen,  // Balance, or zero if frozen
+        frozen,         // The issuer froze the line
+        globalFrozen    // The issuer froze everything
+    };
+
+    struct Key
+    {
+        Kind kind;
+        AccountID account;
+        Currency currency;
+        AccountID issuer;
+
+        friend
+        bool
+        operator== (Key const& lhs, Key const& rhs)
+        {
+            return lhs.kind == rhs.kind &&
+                lhs.account == rhs.account &&
+                lhs.currency == rhs.currency &&
+                lhs.issuer == rhs.issuer;
+        }
+
+        template <class Hasher>
+        friend
+        void
+        hash_append (Hasher& h, Key const& k)
+        {
+            using beast::hash_append;
+            hash_append (h, static_cast<std::uint8_t> (k.kind),
+                k.account, k.currency, k.issuer);
+        }
+    };
+
+    struct Value
+    {
+        STAmount amount;
+        bool frozen = false;
+
+        // The entries this was read from
+        std::array<uint256, 2> deps;
+        std::size_t depCount = 0;
+
+        void
+        dependsOn (uint256 const& key)
+        {
+            assert (depCount < deps.size ());
+            deps[depCount++] = key;
+        }
+    };
+
+private:
+    // Bounds the memory used by a long lived view
+    static std::size_t const maxValues = 4096;
+
+    FundsCache* parent_;
+    hash_map<Key, Value> values_;
+    hash_map<uint256, std::vector<Key>> dependents_;
+    hash_set<uint256> written_;
+    std::size_t depCount_ = 0;
+
+    bool
+    valid (Value const& v) const;
+
+public:
+    explicit
+    FundsCache (FundsCache* parent = nullptr)
+        : parent_ (parent)
+    {
+    }
+
+    FundsCache (FundsCache&&) = default;
+    FundsCache (FundsCache const&) = delete;
+    FundsCache& operator= (FundsCache const&) = delete;
+
+    /** Returns the value for the key, or nullptr. */
+    Value const*
+    find (Key const& key) const;
+
+    /** Remember a value read from the view. */
+    void
+    insert (Key const& key, Value const& value);
+
+    /** Forget everything read from this ledger entry.
+        Called whenever the view writes the entry.
+    */
+    void
+    erase (uint256 const& key);
+};
+
+} // detail
+} // ripple
+
+#endif
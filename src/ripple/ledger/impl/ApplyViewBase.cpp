@@ -28,6 +28,7 @@ ApplyViewBase::ApplyViewBase(
     ReadView const* base, ApplyFlags flags)
     : flags_ (flags)
     , base_ (base)
+    , funds_ (base->fundsCache ())
 {
 }
 
@@ -126,6 +127,12 @@ ApplyViewBase::txRead(
     return base_->txRead(key);
 }
 
+detail::FundsCache*
+ApplyViewBase::fundsCache () const
+{
+    return &funds_;
+}
+
 //---
 
 ApplyFlags
@@ -137,6 +144,8 @@ ApplyViewBase::flags() const
 std::shared_ptr<SLE>
 ApplyViewBase::peek (Keylet const& k)
 {
+    // The caller may change the entry in place
+    funds_.erase(k.key);
     return items_.peek(*base_, k);
 }
 
@@ -144,6 +153,7 @@ void
 ApplyViewBase::erase(
     std::shared_ptr<SLE> const& sle)
 {
+    funds_.erase(sle->key());
     items_.erase(*base_, sle);
 }
 
@@ -151,6 +161,7 @@ void
 ApplyViewBase::insert(
     std::shared_ptr<SLE> const& sle)
 {
+    funds_.erase(sle->key());
     items_.insert(*base_, sle);
 }
 
@@ -158,6 +169,7 @@ void
 ApplyViewBase::update(
     std::shared_ptr<SLE> const& sle)
 {
+    funds_.erase(sle->key());
     items_.update(*base_, sle);
 }
 
@@ -167,6 +179,7 @@ void
 ApplyViewBase::rawErase(
     std::shared_ptr<SLE> const& sle)
 {
+    funds_.erase(sle->key());
     items_.rawErase(*base_, sle);
 }
 
@@ -174,6 +187,7 @@ void
 ApplyViewBase::rawInsert(
     std::shared_ptr<SLE> const& sle)
 {
+    funds_.erase(sle->key());
     items_.insert(*base_, sle);
 }
 
@@ -181,6 +195,7 @@ void
 ApplyViewBase::rawReplace(
     std::shared_ptr<SLE> const& sle)
 {
+    funds_.erase(sle->key());
     items_.replace(*base_, sle);
 }
 
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/ledger/detail/FundsCache.h>
+#include <algorithm>
+
+namespace ripple {
+namespace detail {
+
+bool
+FundsCache::valid (Value const& v) const
+{
+    for (std::size_t i = 0; i < v.depCount; ++i)
+        if (written_.count (v.deps[i]))
+            return false;
+    return true;
+}
+
+auto
+FundsCache::find (Key const& key) const ->
+    Value const*
+{
+    auto const it = values_.find (key);
+    if (it != values_.end ())
+        return &it->second;
+
+    // Our parent's values hold here too, unless we wrote their entries
+    if (parent_)
+    {
+        if (auto const v = parent_->find (key))
+        {
+            if (valid (*v))
+                return v;
+        }
+    }
+    return nullptr;
+}
+
+void
+FundsCache::insert (Key const& key, Value const& value)
+{
+    // A value read through entries we never wrote is the same in the
+    // parent, where views made after this one can find it too.
+    if (parent_ && valid (value))
+    {
+        parent_->insert (key, value);
+        return;
+    }
+
+    if (values_.size () >= maxValues || depCount_ >= 2 * maxValues)
+    {
+        values_.clear ();
+        dependents_.clear ();
+        depCount_ = 0;
+    }
+
+    values_[key] = value;
+    for (std::size_t i = 0; i < value.depCount; ++i)
+        dependents_[value.deps[i]].push_back (key);
+    depCount_ += value.depCount;
+}
+
+void
+FundsCache::erase (uint256 const& key)
+{
+    if (parent_)
+        written_.insert (key);
+
+    auto const it = dependents_.find (key);
+    if (it == dependents_.end ())
+        return;
+    for (auto const& k : it->second)
+        values_.erase (k);
+    depCount_ -= std::min (depCount_, it->second.size ());
+    dependents_.erase (it);
+}
+
+} // detail
+} // ripple
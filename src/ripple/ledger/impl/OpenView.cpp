@@ -111,10 +111,17 @@ OpenView::OpenView (ReadView const* base,
 {
 }
 
+OpenView::OpenView (ReadView const* base,
+        std::size_t baseTxCount)
+    : OpenView (base)
+{
+    baseTxCount_ = baseTxCount;
+}
+
 std::size_t
 OpenView::txCount() const
 {
-    return txs_.size();
+    return baseTxCount_ + txs_.size();
 }
 
 void
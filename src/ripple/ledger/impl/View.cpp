@@ -21,6 +21,7 @@
 #include <ripple/basics/chrono.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/ledger/View.h>
+#include <ripple/ledger/detail/FundsCache.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/StringUtilities.h>
@@ -71,6 +72,24 @@ void addRaw (LedgerInfo const& info, Serializer& s)
     s.add8 (info.closeFlags);
 }
 
+// Returns the value remembered by the view, or
+// computes it with f and remembers it there.
+template <class F>
+static
+detail::FundsCache::Value
+cachedFunds (ReadView const& view,
+    detail::FundsCache::Key const& key, F&& f)
+{
+    auto const cache = view.fundsCache();
+    if (! cache)
+        return f();
+    if (auto const v = cache->find(key))
+        return *v;
+    auto const v = f();
+    cache->insert(key, v);
+    return v;
+}
+
 bool
 isGlobalFrozen (ReadView const& view,
     AccountID const& issuer)
@@ -78,11 +97,17 @@ isGlobalFrozen (ReadView const& view,
     // VFALCO Perhaps this should assert
     if (isXRP (issuer))
         return false;
-    auto const sle =
-        view.read(keylet::account(issuer));
-    if (sle && sle->isFlag (lsfGlobalFreeze))
-        return true;
-    return false;
+    return cachedFunds(view,
+        {detail::FundsCache::Kind::globalFrozen, issuer, {}, issuer},
+        [&]
+        {
+            detail::FundsCache::Value v;
+            auto const k = keylet::account(issuer);
+            auto const sle = view.read(k);
+            v.frozen = sle && sle->isFlag (lsfGlobalFreeze);
+            v.dependsOn(k.key);
+            return v;
+        }).frozen;
 }
 
 // Can the specified account spend the specified currency issued by
@@ -94,21 +119,33 @@ isFrozen (ReadView const& view, AccountID const& account,
 {
     if (isXRP (currency))
         return false;
-    auto sle =
-        view.read(keylet::account(issuer));
-    if (sle && sle->isFlag (lsfGlobalFreeze))
-        return true;
-    if (issuer != account)
-    {
-        // Check if the issuer froze the line
-        sle = view.read(keylet::line(
-            account, issuer, currency));
-        if (sle && sle->isFlag(
-            (issuer > account) ?
-                lsfHighFreeze : lsfLowFreeze))
-            return true;
-    }
-    return false;
+    return cachedFunds(view,
+        {detail::FundsCache::Kind::frozen, account, currency, issuer},
+        [&]
+        {
+            detail::FundsCache::Value v;
+            auto const root = keylet::account(issuer);
+            auto sle =
+                view.read(root);
+            v.dependsOn(root.key);
+            if (sle && sle->isFlag (lsfGlobalFreeze))
+            {
+                v.frozen = true;
+                return v;
+            }
+            if (issuer != account)
+            {
+                // Check if the issuer froze the line
+                auto const line = keylet::line(
+                    account, issuer, currency);
+                sle = view.read(line);
+                v.dependsOn(line.key);
+                v.frozen = sle && sle->isFlag(
+                    (issuer > account) ?
+                        lsfHighFreeze : lsfLowFreeze);
+            }
+            return v;
+        }).frozen;
 }
 
 STAmount
@@ -117,55 +154,73 @@ accountHolds (ReadView const& view,
         AccountID const& issuer, FreezeHandling zeroIfFrozen,
               beast::Journal j)
 {
-    STAmount amount;
-    if (isXRP(currency))
-    {
-        // XRP: return balance minus reserve
-        auto const sle = view.read(
-            keylet::account(account));
-        auto const reserve =
-            view.fees().accountReserve(
-                sle->getFieldU32(sfOwnerCount));
-        auto const balance =
-            sle->getFieldAmount(sfBalance).xrp ();
-        if (balance < reserve)
-            amount.clear ();
-        else
-            amount = balance - reserve;
-        JLOG (j.trace()) << "accountHolds:" <<
-            " account=" << to_string (account) <<
-            " amount=" << amount.getFullText () <<
-            " balance=" << to_string (balance) <<
-            " reserve=" << to_string (reserve);
-    }
-    else
-    {
-        // IOU: Return balance on trust line modulo freeze
-        auto const sle = view.read(keylet::line(
-            account, issuer, currency));
-        if (! sle)
-        {
-            amount.clear ({currency, issuer});
-        }
-        else if ((zeroIfFrozen == fhZERO_IF_FROZEN) &&
-            isFrozen(view, account, currency, issuer))
-        {
-            amount.clear (Issue (currency, issuer));
-        }
-        else
+    auto const kind = (zeroIfFrozen == fhZERO_IF_FROZEN) ?
+        detail::FundsCache::Kind::holdsUnfrozen :
+            detail::FundsCache::Kind::holds;
+
+    // The balance hook is applied afterwards, since it
+    // depends on more than the entries read here.
+    auto const amount = cachedFunds(view,
+        {kind, account, currency, issuer},
+        [&]
         {
-            amount = sle->getFieldAmount (sfBalance);
-            if (account > issuer)
+            detail::FundsCache::Value v;
+            auto& amount = v.amount;
+            if (isXRP(currency))
             {
-                // Put balance in account terms.
-                amount.negate();
+                // XRP: return balance minus reserve
+                auto const k = keylet::account(account);
+                auto const sle = view.read(k);
+                v.dependsOn(k.key);
+                auto const reserve =
+                    view.fees().accountReserve(
+                        sle->getFieldU32(sfOwnerCount));
+                auto const balance =
+                    sle->getFieldAmount(sfBalance).xrp ();
+                if (balance < reserve)
+                    amount.clear ();
+                else
+                    amount = balance - reserve;
+                JLOG (j.trace()) << "accountHolds:" <<
+                    " account=" << to_string (account) <<
+                    " amount=" << amount.getFullText () <<
+                    " balance=" << to_string (balance) <<
+                    " reserve=" << to_string (reserve);
             }
-            amount.setIssuer (issuer);
-        }
-        JLOG (j.trace()) << "accountHolds:" <<
-            " account=" << to_string (account) <<
-            " amount=" << amount.getFullText ();
-    }
+            else
+            {
+                // IOU: Return balance on trust line modulo freeze
+                auto const k = keylet::line(
+                    account, issuer, currency);
+                auto const sle = view.read(k);
+                v.dependsOn(k.key);
+                if (zeroIfFrozen == fhZERO_IF_FROZEN)
+                    v.dependsOn(keylet::account(issuer).key);
+                if (! sle)
+                {
+                    amount.clear ({currency, issuer});
+                }
+                else if ((zeroIfFrozen == fhZERO_IF_FROZEN) &&
+                    isFrozen(view, account, currency, issuer))
+                {
+                    amount.clear (Issue (currency, issuer));
+                }
+                else
+                {
+                    amount = sle->getFieldAmount (sfBalance);
+                    if (account > issuer)
+                    {
+                        // Put balance in account terms.
+                        amount.negate();
+                    }
+                    amount.setIssuer (issuer);
+                }
+                JLOG (j.trace()) << "accountHolds:" <<
+                    " account=" << to_string (account) <<
+                    " amount=" << amount.getFullText ();
+            }
+            return v;
+        }).amount;
 
     return view.balanceHook(
         account, issuer, amount);
@@ -254,6 +254,61 @@ class PaymentSandbox_test : public beast::unit_test::suite
         }
     }
 
+    void testCachedFunds ()
+    {
+        testcase ("Cached funds");
+
+        // Views remember funds and freeze state. Writes through a view
+        // must be seen by it and, once applied, by its parent.
+
+        using namespace jtx;
+        Env env (*this);
+        Account const gw ("gw");
+        Account const alice ("alice");
+        auto const USD = gw["USD"];
+
+        env.fund (XRP (10000), alice, gw);
+        env.trust (USD (100), alice);
+        env (pay (gw, alice, USD (50)));
+
+        auto j = env.app().journal ("View");
+        auto const iss = USD.issue ();
+        auto holds = [&](ReadView const& view)
+        {
+            return accountHolds (view, alice, iss.currency, iss.account,
+                fhZERO_IF_FROZEN, j);
+        };
+
+        ApplyViewImpl av (&*env.current(), tapNONE);
+        expect (holds (av) == USD (50));
+        {
+            PaymentSandbox pv (&av);
+            expect (holds (pv) == USD (50));
+            accountSend (pv, alice, gw, USD (20), j);
+            expect (holds (pv) == USD (30));
+            expect (holds (av) == USD (50));
+
+            // Freezing the line zeroes what alice holds
+            auto const sle = pv.peek (keylet::line (alice, gw, iss.currency));
+            sle->setFlag ((gw.id () > alice.id ()) ?
+                lsfHighFreeze : lsfLowFreeze);
+            pv.update (sle);
+            expect (holds (pv) == beast::zero);
+            expect (holds (av) == USD (50));
+
+            {
+                // A new view sees its parent's writes
+                PaymentSandbox pv2 (&pv);
+                expect (holds (pv2) == beast::zero);
+            }
+
+            pv.apply (av);
+        }
+        expect (holds (av) == beast::zero);
+        expect (accountHolds (av, alice, iss.currency, iss.account,
+            fhIGNORE_FREEZE, j) == USD (30));
+    }
+
     void testTinyBalance ()
     {
         testcase ("Tiny balance");
@@ -296,6 +351,7 @@ public:
     {
         testSelfFunding ();
         testSubtractCredits ();
+        testCachedFunds ();
         testTinyBalance ();
     }
 };
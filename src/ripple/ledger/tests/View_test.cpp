@@ -179,6 +179,76 @@ class View_test
         expect(v.exists(k(3)));
     }
 
+    // Walking an order book in an immutable ledger, and in
+    // views that modify it
+    void
+    testBookDirs()
+    {
+        using namespace jtx;
+        Env env(*this);
+        Config config;
+        std::shared_ptr<Ledger const> const genesis =
+            std::make_shared<Ledger>(
+                create_genesis, config, env.app().family());
+        auto const ledger =
+            std::make_shared<Ledger>(
+                *genesis,
+                env.app().timeKeeper().closeTime());
+        wipe(*ledger);
+
+        auto const base = getBookBase (Book (xrpIssue(),
+            Issue (Currency (1), AccountID (2))));
+        auto const end = getQualityNext (base);
+        auto const dir = [&](std::uint64_t q)
+        {
+            auto const le = std::make_shared<SLE>(Keylet{
+                ltACCOUNT_ROOT, getQualityIndex (base, q)});
+            le->setFieldU32 (sfSequence, 1);
+            return le;
+        };
+        // Just outside the book on either side
+        auto const outside = [&](uint256 key)
+        {
+            auto const le = std::make_shared<SLE>(
+                Keylet{ltACCOUNT_ROOT, key});
+            le->setFieldU32 (sfSequence, 1);
+            return le;
+        };
+        ledger->rawInsert (dir (3));
+        ledger->rawInsert (dir (5));
+        ledger->rawInsert (dir (9));
+        ledger->rawInsert (outside (end));
+        ledger->rawInsert (outside (--uint256 (base)));
+        ledger->setImmutable (config);
+
+        auto const walk = [&](ReadView const& v)
+        {
+            std::vector<std::uint64_t> qualities;
+            auto key = base;
+            while (auto const next = v.succ (key, end))
+            {
+                qualities.push_back (getQuality (*next));
+                key = *next;
+            }
+            return qualities;
+        };
+
+        using Q = std::vector<std::uint64_t>;
+        expect (walk (*ledger) == Q({3, 5, 9}));
+        // A second walk is answered from the same list
+        expect (walk (*ledger) == Q({3, 5, 9}));
+
+        OpenView v0 (ledger.get());
+        v0.rawInsert (dir (4));
+        v0.rawErase (dir (5));
+        expect (walk (v0) == Q({3, 4, 9}));
+
+        Sandbox v1 (&v0, tapNONE);
+        v1.erase (v1.peek (Keylet{ltACCOUNT_ROOT, getQualityIndex (base, 3)}));
+        expect (walk (v1) == Q({4, 9}));
+        expect (walk (*ledger) == Q({3, 5, 9}));
+    }
+
     void
     testMeta()
     {
@@ -790,6 +860,7 @@ class View_test
         expect(k(0).key < k(1).key);
 
         testLedger();
+        testBookDirs();
         testMeta();
         testMetaSucc();
         testStacked();
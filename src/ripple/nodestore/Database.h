@@ -84,6 +84,19 @@ public:
     */
     virtual bool asyncFetch (uint256 const& hash, std::shared_ptr<NodeObject>& object) = 0;
 
+    /** Fetch a group of objects.
+        Objects found in the cache are returned without I/O. The remaining
+        keys are read from the backend in a single batch when the backend
+        supports it, otherwise one at a time.
+        @note This can be called concurrently.
+        @param hashes The keys of the objects to retrieve.
+        @return The objects, in the same order as `hashes`. An entry is
+                `nullptr` if the corresponding object couldn't be retrieved.
+    */
+    virtual
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatch (std::vector<uint256> const& hashes) = 0;
+
     /** Wait for all currently pending async reads to complete.
     */
     virtual void waitReads () = 0;
@@ -274,6 +274,112 @@ public:
         return object;
     }
 
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatch (std::vector<uint256> const& hashes) override
+    {
+        std::vector<std::shared_ptr<NodeObject>> results (hashes.size ());
+
+        // Satisfy what we can from the caches, remember the rest
+        std::vector<uint256> keys;
+        std::vector<std::size_t> slots;
+        for (std::size_t i = 0; i < hashes.size (); ++i)
+        {
+            results[i] = m_cache.fetch (hashes[i]);
+
+            if (! results[i] && ! m_negCache.touch_if_exists (hashes[i]))
+            {
+                keys.push_back (hashes[i]);
+                slots.push_back (i);
+            }
+        }
+
+        if (keys.empty ())
+            return results;
+
+        FetchReport report;
+        report.isAsync = false;
+        report.wentToDisk = true;
+        report.wasFound = false;
+
+        auto const before = std::chrono::steady_clock::now();
+        auto objects = fetchBatchFrom (keys);
+        report.elapsed = std::chrono::duration_cast <std::chrono::milliseconds>
+            (std::chrono::steady_clock::now() - before);
+
+        m_fetchTotalCount += keys.size ();
+
+        for (std::size_t i = 0; i < keys.size (); ++i)
+        {
+            auto& obj = objects[i];
+
+            if (obj)
+            {
+                // Ensure all threads get the same object
+                m_cache.canonicalize (keys[i], obj);
+                report.wasFound = true;
+            }
+            else
+            {
+                // Just in case a write occurred
+                obj = m_cache.fetch (keys[i]);
+
+                if (! obj)
+                    m_negCache.insert (keys[i]);
+            }
+
+            results[slots[i]] = std::move (obj);
+        }
+
+        m_scheduler.onFetch (report);
+
+        JLOG(m_journal.trace()) <<
+            "HOS: batch fetch of " << keys.size () << " in db";
+
+        return results;
+    }
+
+    virtual
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatchFrom (std::vector<uint256> const& keys)
+    {
+        return fetchBatchInternal (*m_backend, keys);
+    }
+
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatchInternal (Backend& backend, std::vector<uint256> const& keys)
+    {
+        if (! backend.canFetchBatch ())
+        {
+            std::vector<std::shared_ptr<NodeObject>> objects;
+            objects.reserve (keys.size ());
+
+            for (auto const& key : keys)
+                objects.push_back (fetchInternal (backend, key));
+
+            return objects;
+        }
+
+        std::vector<void const*> ptrs;
+        ptrs.reserve (keys.size ());
+
+        for (auto const& key : keys)
+            ptrs.push_back (key.begin ());
+
+        auto objects = backend.fetchBatch (ptrs.size (), ptrs.data ());
+        assert (objects.size () == keys.size ());
+
+        for (auto const& object : objects)
+        {
+            if (object)
+            {
+                ++m_fetchHitCount;
+                m_fetchSize += object->getData().size();
+            }
+        }
+
+        return objects;
+    }
+
     //------------------------------------------------------------------------------
 
     void store (NodeObjectType type,
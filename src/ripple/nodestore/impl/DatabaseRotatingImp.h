@@ -125,6 +125,10 @@ public:
     }
 
     std::shared_ptr<NodeObject> fetchFrom (uint256 const& hash) override;
+
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatchFrom (std::vector<uint256> const& keys) override;
+
     TaggedCache <uint256, NodeObject>& getPositiveCache() override
     {
         return m_cache;
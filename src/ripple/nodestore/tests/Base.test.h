@@ -212,6 +212,27 @@ public:
                 pCopy->push_back (object);
         }
     }
+
+    // Fetch all the hashes with a single batch fetch, into another batch.
+    static void fetchBatchCopyOfBatch (Database& db,
+                                       Batch* pCopy,
+                                       Batch const& batch)
+    {
+        std::vector<uint256> hashes;
+        hashes.reserve (batch.size ());
+
+        for (int i = 0; i < batch.size (); ++i)
+            hashes.push_back (batch [i]->getHash ());
+
+        pCopy->clear ();
+        pCopy->reserve (batch.size ());
+
+        for (auto& object : db.fetchBatch (hashes))
+        {
+            if (object != nullptr)
+                pCopy->push_back (std::move (object));
+        }
+    }
 };
 
 }
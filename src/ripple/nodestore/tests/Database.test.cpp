@@ -126,6 +126,13 @@ public:
                 expect (areBatchesEqual (batch, copy), "Should be equal");
             }
 
+            {
+                // Read it back in with a batch fetch
+                Batch copy;
+                fetchBatchCopyOfBatch (*db, &copy, batch);
+                expect (areBatchesEqual (batch, copy), "Should be equal");
+            }
+
             {
                 // Reorder and read the copy again
                 std::shuffle (
@@ -154,6 +161,16 @@ public:
                 std::sort (copy.begin (), copy.end (), LessThan{});
                 expect (areBatchesEqual (batch, copy), "Should be equal");
             }
+
+            {
+                // Re-open the database and read it back in one batch
+                std::unique_ptr <Database> db = Manager::instance().make_Database (
+                    "test", scheduler, j, 2, nodeParams);
+
+                Batch copy;
+                fetchBatchCopyOfBatch (*db, &copy, batch);
+                expect (areBatchesEqual (batch, copy), "Should be equal");
+            }
         }
     }
 
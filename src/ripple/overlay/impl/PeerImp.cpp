@@ -25,6 +25,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/LedgerTiming.h>
 #include <ripple/app/ledger/InboundTransactions.h>
+#include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/misc/Transaction.h>
@@ -1067,11 +1068,10 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMTransaction> const& m)
         return;
     }
 
-    SerialIter sit (makeSlice(m->rawtransaction()));
-
     try
     {
-        auto stx = std::make_shared<STTx const>(sit);
+        auto stx = app_.getMasterTransaction().parse (
+            makeSlice(m->rawtransaction()));
         uint256 txID = stx->getTransactionID ();
 
         int flags;
@@ -1710,6 +1710,7 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMGetObjectByHash> const& m)
         std::uint32_t pLSeq = 0;
         bool pLDo = true;
         bool progress = false;
+        std::vector<std::pair<uint256, std::shared_ptr<Blob>>> packs;
 
         for (int i = 0; i < packet.objects_size (); ++i)
         {
@@ -1748,11 +1749,14 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMGetObjectByHash> const& m)
                         std::make_shared< Blob > (
                             obj.data ().begin (), obj.data ().end ()));
 
-                    app_.getLedgerMaster ().addFetchPack (hash, data);
+                    packs.emplace_back (hash, std::move (data));
                 }
             }
         }
 
+        if (! packs.empty ())
+            app_.getLedgerMaster ().addFetchPacks (packs);
+
         if (pLDo && (pLSeq != 0))
         {
             JLOG(p_journal_.debug()) <<
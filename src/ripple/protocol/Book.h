@@ -59,8 +59,9 @@ template <class Hasher>
 void
 hash_append (Hasher& h, Book const& b)
 {
-    using beast::hash_append;
-    hash_append(h, b.in, b.out);
+    // See hash_append for Issue
+    static_assert (sizeof (Book) == sizeof (b.in) + sizeof (b.out), "");
+    h (&b, sizeof (b));
 }
 
 Book
@@ -22,7 +22,10 @@
 
 #include <ripple/protocol/SField.h>
 #include <boost/range.hpp>
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace ripple {
 
@@ -64,6 +67,25 @@ public:
     using list_type = std::vector <std::unique_ptr <SOElement const>>;
     using iterator_range = boost::iterator_range<list_type::const_iterator>;
 
+    /** How an element appears in the serialized form.
+        These are computed once when the template is built, so
+        that objects of this type serialize without sorting.
+    */
+    struct Encoding
+    {
+        // Position of the element in the template
+        std::size_t index;
+
+        SField const* field;
+
+        // The field ID as written by Serializer::addFieldID
+        std::array <std::uint8_t, 3> id;
+        std::uint8_t idSize;
+
+        // The end marker that follows an object or array, or zero
+        std::uint8_t end;
+    };
+
     /** Create an empty template.
         After creating the template, call @ref push_back with the
         desired fields.
@@ -74,6 +96,7 @@ public:
     SOTemplate(SOTemplate&& other)
         : mTypes(std::move(other.mTypes))
         , mIndex(std::move(other.mIndex))
+        , mEncoding(std::move(other.mEncoding))
     {
     }
 
@@ -101,10 +124,19 @@ public:
         return mTypes[mIndex[sf.getNum()]]->flags;
     }
 
+    /** The elements in canonical (field code) order. */
+    std::vector <Encoding> const&
+    encoding () const
+    {
+        return mEncoding;
+    }
+
 private:
     list_type mTypes;
 
     std::vector <int> mIndex;       // field num -> index
+
+    std::vector <Encoding> mEncoding;
 };
 
 } // ripple
@@ -282,6 +282,26 @@ private:
 
 //------------------------------------------------------------------------------
 
+/** A Serializer that borrows its storage from a per-thread cache.
+
+    Use this when the serialized data is consumed before the
+    serializer is destroyed, as when hashing or copying into a
+    message. The buffer's capacity is returned to the cache and
+    reused, so in the common case nothing is allocated. Do not
+    move the data out.
+*/
+class ScratchSerializer : public Serializer
+{
+public:
+    ScratchSerializer ();
+    ~ScratchSerializer ();
+
+    ScratchSerializer (ScratchSerializer const&) = delete;
+    ScratchSerializer& operator= (ScratchSerializer const&) = delete;
+};
+
+//------------------------------------------------------------------------------
+
 // DEPRECATED
 // Transitional adapter to new serialization interfaces
 class SerialIter
@@ -23,6 +23,7 @@
 #include <ripple/basics/base_uint.h>
 #include <ripple/beast/crypto/ripemd.h>
 #include <ripple/beast/crypto/sha2.h>
+#include <ripple/beast/crypto/sha512_multi.h>
 #include <ripple/beast/hash/endian.h>
 #include <algorithm>
 #include <array>
@@ -291,6 +292,16 @@ sha512Half_s (Args const&... args)
         sha512_half_hasher_s::result_type>(h);
 }
 
+/** Computes the SHA512-Half of several independent messages.
+
+    out[i] receives the SHA512-Half of messages[i]. When the
+    processor has wide enough vector units the messages are
+    hashed side by side, otherwise they are hashed in turn.
+*/
+void
+sha512HalfMulti (beast::sha512_message const* messages,
+    std::size_t count, uint256* out);
+
 } // ripple
 
 #endif
@@ -24,16 +24,18 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 namespace ripple {
 
 // These must stay at the top of this file, and in this order
 // Files-cope statics are preferred here because the SFields must be
-// file-scope.  The following 3 objects must have scope prior to
+// file-scope.  The following 4 objects must have scope prior to
 // the file-scope SFields.
 static std::mutex SField_mutex;
 static std::map<int, SField const*> knownCodeToField;
+static std::unordered_map<std::string, SField const*> knownNameToField;
 static std::map<int, std::unique_ptr<SField const>> unknownCodeToField;
 
 // Storage for static const member.
@@ -50,7 +52,7 @@ struct SField::make
     static SField one(SField const* p, Args&& ...args)
     {
         SField result(std::forward<Args>(args)...);
-        knownCodeToField[result.fieldCode] = p;
+        add (p, result);
         return result;
     }
 
@@ -58,9 +60,21 @@ struct SField::make
     static TypedField<T> one(SField const* p, Args&& ...args)
     {
         TypedField<T> result(std::forward<Args>(args)...);
-        knownCodeToField[result.fieldCode] = p;
+        add (p, result);
         return result;
     }
+
+    static void add (SField const* p, SField const& f)
+    {
+        knownCodeToField[f.fieldCode] = p;
+
+        // When names collide the lowest code wins, as it
+        // would in a search of knownCodeToField
+        auto const result = knownNameToField.emplace (f.fieldName, p);
+        if (! result.second &&
+                (f.fieldCode < result.first->second->fieldCode))
+            result.first->second = p;
+    }
 };
 
 using make = SField::make;
@@ -376,11 +390,11 @@ std::string SField::getName () const
 SField const&
 SField::getField (std::string const& fieldName)
 {
-    for (auto const & fieldPair : knownCodeToField)
-    {
-        if (fieldPair.second->fieldName == fieldName)
-            return * (fieldPair.second);
-    }
+    auto const it = knownNameToField.find (fieldName);
+
+    if (it != knownNameToField.end ())
+        return * (it->second);
+
     {
         StaticScopedLockType sl (SField_mutex);
 
@@ -19,9 +19,43 @@
 
 #include <BeastConfig.h>
 #include <ripple/protocol/SOTemplate.h>
+#include <algorithm>
+#include <cassert>
 
 namespace ripple {
 
+// Mirrors Serializer::addFieldID
+static
+std::uint8_t
+encodeFieldID (SField const& f, std::array <std::uint8_t, 3>& id)
+{
+    int const type = f.fieldType;
+    int const name = f.fieldValue;
+    assert ((type > 0) && (type < 256) && (name > 0) && (name < 256));
+
+    if (type < 16)
+    {
+        if (name < 16)
+        {
+            id[0] = static_cast<std::uint8_t> ((type << 4) | name);
+            return 1;
+        }
+        id[0] = static_cast<std::uint8_t> (type << 4);
+        id[1] = static_cast<std::uint8_t> (name);
+        return 2;
+    }
+    if (name < 16)
+    {
+        id[0] = static_cast<std::uint8_t> (name);
+        id[1] = static_cast<std::uint8_t> (type);
+        return 2;
+    }
+    id[0] = 0;
+    id[1] = static_cast<std::uint8_t> (type);
+    id[2] = static_cast<std::uint8_t> (name);
+    return 3;
+}
+
 void SOTemplate::push_back (SOElement const& r)
 {
     // Ensure there is the enough space in the index mapping
@@ -46,6 +80,25 @@ void SOTemplate::push_back (SOElement const& r)
     //
     mIndex [r.e_field.getNum ()] = mTypes.size ();
 
+    // Record how the element is serialized, keeping
+    // the encodings sorted by field code.
+    //
+    Encoding e;
+    e.index = mTypes.size ();
+    e.field = &r.e_field;
+    e.idSize = encodeFieldID (r.e_field, e.id);
+    if (r.e_field.fieldType == STI_ARRAY)
+        e.end = 0xf1;
+    else if (r.e_field.fieldType == STI_OBJECT)
+        e.end = 0xe1;
+    else
+        e.end = 0;
+    mEncoding.insert (std::upper_bound (mEncoding.begin (), mEncoding.end (),
+        e, [](Encoding const& a, Encoding const& b)
+        {
+            return a.field->fieldCode < b.field->fieldCode;
+        }), e);
+
     // Append the new element.
     //
     mTypes.push_back (std::make_unique<SOElement const> (r));
@@ -53,9 +106,10 @@ void SOTemplate::push_back (SOElement const& r)
 
 int SOTemplate::getIndex (SField const& f) const
 {
-    // The mapping table should be large enough for any possible field
+    // Fields created after the template was built are not in it
     //
-    assert (f.getNum () < mIndex.size ());
+    if (f.getNum () >= static_cast<int> (mIndex.size ()))
+        return -1;
 
     return mIndex[f.getNum ()];
 }
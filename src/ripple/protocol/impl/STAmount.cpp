@@ -22,14 +22,15 @@
 #include <ripple/basics/contract.h>
 #include <ripple/basics/Log.h>
 #include <ripple/protocol/JsonFields.h>
-#include <ripple/crypto/CBigNum.h>
 #include <ripple/protocol/SystemParameters.h>
 #include <ripple/protocol/STAmount.h>
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/beast/core/LexicalCast.h>
 #include <boost/regex.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <iostream>
 
@@ -980,6 +981,28 @@ operator- (STAmount const& value)
 // Arithmetic
 //
 //------------------------------------------------------------------------------
+
+// Compute (value * mul + add) / div without overflowing.
+// A quotient that does not fit in 64 bits yields the
+// largest 64-bit value, matching the bignum code this
+// replaced on 64-bit platforms.
+static
+std::uint64_t
+muldiv (std::uint64_t value, std::uint64_t mul,
+    std::uint64_t add, std::uint64_t div)
+{
+    using namespace boost::multiprecision;
+
+    uint128_t v (value);
+    v *= mul;
+    v += add;
+    v /= div;
+
+    if (v > std::numeric_limits<std::uint64_t>::max())
+        return std::numeric_limits<std::uint64_t>::max();
+    return static_cast<std::uint64_t> (v);
+}
+
 STAmount
 divide (STAmount const& num, STAmount const& den, Issue const& issue)
 {
@@ -1014,20 +1037,11 @@ divide (STAmount const& num, STAmount const& den, Issue const& issue)
     }
 
     // Compute (numerator * 10^17) / denominator
-    CBigNum v;
-
-    if ((BN_add_word64 (&v, numVal) != 1) ||
-            (BN_mul_word64 (&v, tenTo17) != 1) ||
-            (BN_div_word64 (&v, denVal) != 1))
-    {
-        Throw<std::runtime_error> ("internal bn error");
-    }
-
     // 10^16 <= quotient <= 10^18
-    assert (BN_num_bytes (&v) <= 64);
+    auto const v = muldiv (numVal, tenTo17, 0, denVal);
 
     // TODO(tom): where do 5 and 17 come from?
-    return STAmount (issue, v.getuint64 () + 5,
+    return STAmount (issue, v + 5,
                      numOffset - denOffset - 17,
                      num.negative() != den.negative());
 }
@@ -1078,21 +1092,11 @@ multiply (STAmount const& v1, STAmount const& v2, Issue const& issue)
     }
 
     // Compute (numerator * denominator) / 10^14 with rounding
-    // 10^16 <= result <= 10^18
-    CBigNum v;
-
-    if ((BN_add_word64 (&v, value1) != 1) ||
-            (BN_mul_word64 (&v, value2) != 1) ||
-            (BN_div_word64 (&v, tenTo14) != 1))
-    {
-        Throw<std::runtime_error> ("internal bn error");
-    }
-
     // 10^16 <= product <= 10^18
-    assert (BN_num_bytes (&v) <= 64);
+    auto const v = muldiv (value1, value2, 0, tenTo14);
 
     // TODO(tom): where do 7 and 14 come from?
-    return STAmount (issue, v.getuint64 () + 7,
+    return STAmount (issue, v + 7,
         offset1 + offset2 + 14, v1.negative() != v2.negative());
 }
 
@@ -1181,22 +1185,10 @@ mulRound (STAmount const& v1, STAmount const& v2, Issue const& issue,
 
     bool resultNegative = v1.negative() != v2.negative();
     // Compute (numerator * denominator) / 10^14 with rounding
-    // 10^16 <= result <= 10^18
-    CBigNum v;
-
-    if ((BN_add_word64 (&v, value1) != 1) || (BN_mul_word64 (&v, value2) != 1))
-        Throw<std::runtime_error> ("internal bn error");
-
-    if (resultNegative != roundUp) // rounding down is automatic when we divide
-        BN_add_word64 (&v, tenTo14m1);
-
-    if  (BN_div_word64 (&v, tenTo14) != 1)
-        Throw<std::runtime_error> ("internal bn error");
-
     // 10^16 <= product <= 10^18
-    assert (BN_num_bytes (&v) <= 64);
-
-    std::uint64_t amount = v.getuint64 ();
+    // Rounding down is automatic when we divide
+    std::uint64_t amount = muldiv (value1, value2,
+        (resultNegative != roundUp) ? tenTo14m1 : 0, tenTo14);
     int offset = offset1 + offset2 + 14;
     canonicalizeRound (
         isXRP (issue), amount, offset, resultNegative != roundUp);
@@ -1251,21 +1243,10 @@ divRound (STAmount const& num, STAmount const& den,
 
     bool resultNegative = num.negative() != den.negative();
     // Compute (numerator * 10^17) / denominator
-    CBigNum v;
-
-    if ((BN_add_word64 (&v, numVal) != 1) || (BN_mul_word64 (&v, tenTo17) != 1))
-        Throw<std::runtime_error> ("internal bn error");
-
-    if (resultNegative != roundUp) // Rounding down is automatic when we divide
-        BN_add_word64 (&v, denVal - 1);
-
-    if (BN_div_word64 (&v, denVal) != 1)
-        Throw<std::runtime_error> ("internal bn error");
-
     // 10^16 <= quotient <= 10^18
-    assert (BN_num_bytes (&v) <= 64);
-
-    std::uint64_t amount = v.getuint64 ();
+    // Rounding down is automatic when we divide
+    std::uint64_t amount = muldiv (numVal, tenTo17,
+        (resultNegative != roundUp) ? denVal - 1 : 0, denVal);
     int offset = numOffset - denOffset - 17;
     canonicalizeRound (
         isXRP (issue), amount, offset, resultNegative != roundUp);
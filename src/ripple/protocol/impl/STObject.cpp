@@ -102,24 +102,42 @@ bool STObject::setType (const SOTemplate& type)
 {
     bool valid = true;
     mType = &type;
+
+    // Place each field at its position in the template
+    std::vector<detail::STVar*> placed (type.size(), nullptr);
+    for (auto& e : v_)
+    {
+        auto const i = type.getIndex (e->getFName());
+        if (i == -1 || placed[i] != nullptr)
+        {
+            // Anything left over in the object must be discardable
+            if (! e->getFName().isDiscardable())
+            {
+                JLOG (debugJournal().warn())
+                    << "setType(" << getFName().getName()
+                    << "): non-discardable leftover " << e->getFName().getName ();
+                valid = false;
+            }
+            continue;
+        }
+        placed[i] = &e;
+    }
+
     decltype(v_) v;
     v.reserve(type.size());
+    auto iter = placed.begin();
     for (auto const& e : type.all())
     {
-        auto const iter = std::find_if(
-            v_.begin(), v_.end(), [&](detail::STVar const& b)
-                { return b.get().getFName() == e->e_field; });
-        if (iter != v_.end())
+        if (auto const field = *iter++)
         {
-            if ((e->flags == SOE_DEFAULT) && iter->get().isDefault())
+            if ((e->flags == SOE_DEFAULT) && field->get().isDefault())
             {
                 JLOG (debugJournal().warn())
                     << "setType(" << getFName().getName()
                     << "): explicit default " << e->e_field.fieldName;
                 valid = false;
             }
-            v.emplace_back(std::move(*iter));
-            v_.erase(iter);
+            v.emplace_back(std::move(*field));
         }
         else
         {
@@ -133,17 +151,6 @@ bool STObject::setType (const SOTemplate& type)
             v.emplace_back(detail::nonPresentObject, e->e_field);
         }
     }
-    for (auto const& e : v_)
-    {
-        // Anything left over in the object must be discardable
-        if (! e->getFName().isDiscardable())
-        {
-            JLOG (debugJournal().warn())
-                << "setType(" << getFName().getName()
-                << "): non-discardable leftover " << e->getFName().getName ();
-            valid = false;
-        }
-    }
     // Swap the template matching data in for the old data,
     // freeing any leftover junk
     v_.swap(v);
@@ -231,8 +238,8 @@ bool STObject::set (SerialIter& sit, int depth)
             v_.emplace_back(sit, fn);
 
             // If the object type has a known SOTemplate then set it.
-            STObject* const obj = dynamic_cast <STObject*> (&(v_.back().get()));
-            if (obj && (obj->setTypeFromSField (fn) == typeSetFail))
+            if ((fn.fieldType == STI_OBJECT) && (static_cast<STObject&> (
+                v_.back().get()).setTypeFromSField (fn) == typeSetFail))
             {
                 Throw<std::runtime_error> ("field deserialization error");
             }
@@ -314,7 +321,7 @@ bool STObject::isEquivalent (const STBase& t) const
 
 uint256 STObject::getHash (std::uint32_t prefix) const
 {
-    Serializer s;
+    ScratchSerializer s;
     s.add32 (prefix);
     add (s, true);
     return s.getSHA512Half ();
@@ -322,7 +329,7 @@ uint256 STObject::getHash (std::uint32_t prefix) const
 
 uint256 STObject::getSigningHash (std::uint32_t prefix) const
 {
-    Serializer s;
+    ScratchSerializer s;
     s.add32 (prefix);
     add (s, false);
     return s.getSHA512Half ();
@@ -742,6 +749,26 @@ bool STObject::operator== (const STObject& obj) const
 
 void STObject::add (Serializer& s, bool withSigningFields) const
 {
+    // A templated object holds its fields in template order, and
+    // the template knows their canonical order and encoded IDs.
+    if (mType && (v_.size() == mType->size()))
+    {
+        for (auto const& e : mType->encoding())
+        {
+            auto const& field = v_[e.index].get();
+            if ((field.getSType() == STI_NOTPRESENT) ||
+                    ! e.field->shouldInclude (withSigningFields))
+                continue;
+
+            assert (field.getFName() == *e.field);
+            s.addRaw (e.id.data(), e.idSize);
+            field.add (s);
+            if (e.end != 0)
+                s.add8 (e.end);
+        }
+        return;
+    }
+
     std::map<int, STBase const*> fields;
     for (auto const& e : v_)
     {
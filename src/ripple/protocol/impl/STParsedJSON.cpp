@@ -160,20 +160,13 @@ non_object_in_array (std::string const& item, Json::UInt index)
 static boost::optional<detail::STVar> parseLeaf (
     std::string const& json_name,
     std::string const& fieldName,
+    SField const& field,
     SField const* name,
     Json::Value const& value,
     Json::Value& error)
 {
     boost::optional <detail::STVar> ret;
 
-    auto const& field = SField::getField (fieldName);
-
-    if (field == sfInvalid)
-    {
-        error = unknown_field (json_name, fieldName);
-        return ret;
-    }
-
     switch (field.fieldType)
     {
     case STI_UINT8:
@@ -688,9 +681,10 @@ static boost::optional <STObject> parseObject (
 
     STObject data (inName);
 
-    for (auto const& fieldName : json.getMemberNames ())
+    for (auto iter = json.begin (); iter != json.end (); ++iter)
     {
-        Json::Value const& value = json [fieldName];
+        std::string const fieldName = iter.memberName ();
+        Json::Value const& value = *iter;
 
         auto const& field = SField::getField (fieldName);
 
@@ -751,8 +745,8 @@ static boost::optional <STObject> parseObject (
         // Everything else (types that don't recurse).
         default:
             {
-                auto leaf =
-                    parseLeaf (json_name, fieldName, &inName, value, error);
+                auto leaf = parseLeaf (
+                    json_name, fieldName, field, &inName, value, error);
 
                 if (!leaf)
                     return boost::none;
@@ -808,10 +802,8 @@ static boost::optional <detail::STVar> parseArray (
                 return boost::none;
             }
 
-            // TODO: There doesn't seem to be a nice way to get just the
-            // first/only key in an object without copying all keys into
-            // a vector
-            std::string const objectName (json[i].getMemberNames()[0]);;
+            auto const member = json[i].begin ();
+            std::string const objectName (member.memberName ());
             auto const&       nameField (SField::getField(objectName));
 
             if (nameField == sfInvalid)
@@ -820,7 +812,7 @@ static boost::optional <detail::STVar> parseArray (
                 return boost::none;
             }
 
-            Json::Value const objectFields (json[i][objectName]);
+            Json::Value const& objectFields (*member);
 
             std::stringstream ss;
             ss << json_name << "." <<
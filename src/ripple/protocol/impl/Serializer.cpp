@@ -22,9 +22,56 @@
 #include <ripple/basics/Log.h>
 #include <ripple/protocol/digest.h>
 #include <ripple/protocol/Serializer.h>
+#include <boost/thread/tss.hpp>
+#include <vector>
 
 namespace ripple {
 
+namespace detail {
+
+// Buffers released by ScratchSerializer, kept per thread
+static
+std::vector<Blob>&
+scratchBuffers ()
+{
+    static
+    boost::thread_specific_ptr<std::vector<Blob>> buffers;
+
+    if (!buffers.get())
+        buffers.reset (new std::vector<Blob>);
+
+    return *buffers;
+}
+
+} // detail
+
+ScratchSerializer::ScratchSerializer ()
+    : Serializer (0)
+{
+    auto& buffers = detail::scratchBuffers ();
+    if (buffers.empty ())
+    {
+        reserve (256);
+        return;
+    }
+    modData ().swap (buffers.back ());
+    buffers.pop_back ();
+}
+
+ScratchSerializer::~ScratchSerializer ()
+{
+    // Don't hold on to very large buffers, or too many
+    static std::size_t const maxCapacity = 64 * 1024;
+    static std::size_t const maxBuffers = 8;
+
+    auto& buffers = detail::scratchBuffers ();
+    if ((capacity () > maxCapacity) || (buffers.size () >= maxBuffers))
+        return;
+    erase ();
+    buffers.emplace_back ();
+    buffers.back ().swap (modData ());
+}
+
 int Serializer::addZeros (size_t uBytes)
 {
     int ret = mData.size ();
@@ -19,6 +19,7 @@
 
 #include <BeastConfig.h>
 #include <ripple/protocol/digest.h>
+#include <algorithm>
 #include <type_traits>
 #include <openssl/ripemd.h>
 #include <openssl/sha.h>
@@ -113,4 +114,33 @@ openssl_sha256_hasher::operator result_type() noexcept
     return digest;
 }
 
+//------------------------------------------------------------------------------
+
+void
+sha512HalfMulti (beast::sha512_message const* messages,
+    std::size_t count, uint256* out)
+{
+    if (count > 1 && beast::sha512_multi_lanes() > 1)
+    {
+        std::array<beast::sha512_digest, 64> digests;
+        for (std::size_t i = 0; i < count; i += digests.size())
+        {
+            auto const n = std::min(digests.size(), count - i);
+            beast::sha512_multi(messages + i, n, digests.data());
+            for (std::size_t j = 0; j < n; ++j)
+                std::copy(digests[j].begin(),
+                    digests[j].begin() + 32, out[i + j].begin());
+        }
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sha512_half_hasher h;
+        for (std::size_t j = 0; j < messages[i].parts; ++j)
+            h(messages[i].data[j], messages[i].size[j]);
+        out[i] = static_cast<uint256>(h);
+    }
+}
+
 } // ripple
@@ -88,61 +88,119 @@ checksum (void* out,
 
 //------------------------------------------------------------------------------
 
+/*  Base-58 encoding works on numbers held in 32-bit limbs.
+
+    The base58 side uses limbs of 58^5, five digits at a time, and
+    the binary side uses limbs of 2^32, four bytes at a time. Each
+    pass multiplies by at most 2^32 (or 58^5) and adds a carry, which
+    fits in 64 bits, so a 20 or 33 byte token takes a handful of
+    passes over a few limbs instead of one pass per byte over every
+    output digit.
+*/
+static std::uint32_t const b58Limb = 58 * 58 * 58 * 58 * 58;
+
+// Limb storage that lives on the stack for the sizes used by
+// Ripple tokens, and on the heap for anything larger.
+class LimbBuffer
+{
+private:
+    std::uint32_t buf_[32];
+    std::unique_ptr<std::uint32_t[]> pbuf_;
+    std::uint32_t* data_;
+
+public:
+    explicit
+    LimbBuffer (std::size_t size)
+    {
+        if (size > 32)
+        {
+            pbuf_.reset(new std::uint32_t[size]);
+            data_ = pbuf_.get();
+        }
+        else
+        {
+            data_ = buf_;
+        }
+    }
+
+    std::uint32_t&
+    operator[](std::size_t i)
+    {
+        return data_[i];
+    }
+};
+
 // Code from Bitcoin: https://github.com/bitcoin/bitcoin
 // Copyright (c) 2014 The Bitcoin Core developers
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 //
 // Modified from the original
-//
-// WARNING Do not call this directly, use
-//         encodeBase58Token instead since it
-//         calculates the size of buffer needed.
 static
 std::string
 encodeBase58(
     void const* message, std::size_t size,
-        void *temp, char const* const alphabet)
+        char const* const alphabet)
 {
     auto pbegin = reinterpret_cast<
         unsigned char const*>(message);
     auto const pend = pbegin + size;
     // Skip & count leading zeroes.
-    int zeroes = 0;
+    std::size_t zeroes = 0;
     while (pbegin != pend && *pbegin == 0)
     {
         pbegin++;
         zeroes++;
     }
-    auto const b58begin = reinterpret_cast<
-        unsigned char*>(temp);
-    // log(256) / log(58), rounded up.
-    auto const b58end = b58begin +
-        size * (138 / 100 + 1);
-    std::fill(b58begin, b58end, 0);
+    // log(256) / log(58^5), rounded up.
+    LimbBuffer limbs ((pend - pbegin) * 28 / 100 + 2);
+    std::size_t used = 0;
+    // Consume the input four bytes at a time, starting with
+    // whatever is left over so the rest divides evenly.
+    auto chunk = (pend - pbegin) % 4;
+    if (chunk == 0)
+        chunk = 4;
     while (pbegin != pend)
     {
-        int carry = *pbegin;
-        // Apply "b58 = b58 * 256 + ch".
-        for (auto iter = b58end; iter != b58begin; --iter)
+        std::uint64_t carry = 0;
+        for (auto i = 0; i < chunk; ++i)
+            carry = (carry << 8) | *pbegin++;
+        std::uint64_t const mul =
+            std::uint64_t(1) << (8 * chunk);
+        // Apply "b58 = b58 * 256^chunk + carry".
+        for (std::size_t i = 0; i < used; ++i)
         {
-            carry += 256 * (iter[-1]);
-            iter[-1] = carry % 58;
-            carry /= 58;
+            carry += limbs[i] * mul;
+            limbs[i] = carry % b58Limb;
+            carry /= b58Limb;
         }
-        assert(carry == 0);
-        pbegin++;
+        while (carry != 0)
+        {
+            limbs[used++] = carry % b58Limb;
+            carry /= b58Limb;
+        }
+        chunk = 4;
     }
-    // Skip leading zeroes in base58 result.
-    auto iter = b58begin;
-    while (iter != b58end && *iter == 0)
-        ++iter;
-    // Translate the result into a string.
+    // Translate the result into a string, leaving out
+    // leading zeroes of the most significant limb.
+    char digits[5];
     std::string str;
-    str.reserve(zeroes + (b58end - iter));
+    str.reserve(zeroes + used * 5);
     str.assign(zeroes, alphabet[0]);
-    while (iter != b58end)
-        str += alphabet[*(iter++)];
+    for (auto i = used; i-- != 0;)
+    {
+        auto v = limbs[i];
+        for (auto j = 5; j-- != 0;)
+        {
+            digits[j] = alphabet[v % 58];
+            v /= 58;
+        }
+        auto first = 0;
+        if (i == used - 1)
+            while (digits[first] == alphabet[0])
+                ++first;
+        str.append(digits + first, 5 - first);
+    }
     return str;
 }
 
@@ -165,18 +223,15 @@ std::string
 base58EncodeToken (std::uint8_t type,
     void const* token, std::size_t size)
 {
-    char buf[1024];
+    char buf[128];
     // expanded token includes type + checksum
     auto const expanded = 1 + size + 4;
-    // add scratch, log(256) / log(58), rounded up.
-    auto const needed = expanded +
-        size * (138 / 100 + 1);
     std::unique_ptr<
         char[]> pbuf;
     char* temp;
-    if (needed > sizeof(buf))
+    if (expanded > sizeof(buf))
     {
-        pbuf.reset(new char[needed]);
+        pbuf.reset(new char[expanded]);
         temp = pbuf.get();
     }
     else
@@ -188,8 +243,7 @@ base58EncodeToken (std::uint8_t type,
     temp[0] = type;
     std::memcpy(temp + 1, token, size);
     checksum(temp + 1 + size, temp, 1 + size);
-    return encodeBase58(temp, expanded,
-        temp + expanded, rippleAlphabet);
+    return encodeBase58(temp, expanded, rippleAlphabet);
 }
 
 //------------------------------------------------------------------------------
@@ -209,43 +263,63 @@ decodeBase58 (std::string const& s,
     auto psz = s.c_str();
     auto remain = s.size();
     // Skip and count leading zeroes
-    int zeroes = 0;
+    std::size_t zeroes = 0;
     while (remain > 0 && inv[*psz] == 0)
     {
         ++zeroes;
         ++psz;
         --remain;
     }
-    // Allocate enough space in big-endian base256 representation.
-    // log(58) / log(256), rounded up.
-    std::vector<unsigned char> b256(
-        remain * 733 / 1000 + 1);
+    // log(58) / log(2^32), rounded up.
+    LimbBuffer limbs (remain * 733 / 4000 + 2);
+    std::size_t used = 0;
+    // Consume the digits five at a time, starting with
+    // whatever is left over so the rest divides evenly.
+    auto chunk = remain % 5;
+    if (chunk == 0)
+        chunk = 5;
     while (remain > 0)
     {
-        auto carry = inv[*psz];
-        if (carry == -1)
-            return {};
-        // Apply "b256 = b256 * 58 + carry".
-        for (auto iter = b256.rbegin();
-            iter != b256.rend(); ++iter)
+        std::uint64_t carry = 0;
+        std::uint64_t mul = 1;
+        for (std::size_t i = 0; i < chunk; ++i)
         {
-            carry += 58 * *iter;
-            *iter = carry % 256;
-            carry /= 256;
+            auto const digit = inv[*psz++];
+            if (digit == -1)
+                return {};
+            carry = carry * 58 + digit;
+            mul *= 58;
         }
-        assert(carry == 0);
-        ++psz;
-        --remain;
+        remain -= chunk;
+        // Apply "b256 = b256 * 58^chunk + carry".
+        for (std::size_t i = 0; i < used; ++i)
+        {
+            carry += limbs[i] * mul;
+            limbs[i] = static_cast<std::uint32_t>(carry);
+            carry >>= 32;
+        }
+        while (carry != 0)
+        {
+            limbs[used++] = static_cast<std::uint32_t>(carry);
+            carry >>= 32;
+        }
+        chunk = 5;
     }
-    // Skip leading zeroes in b256.
-    auto iter = std::find_if(
-        b256.begin(), b256.end(),[](unsigned char c)
-            { return c != 0; });
+    // Write out big-endian bytes, leaving out leading
+    // zeroes of the most significant limb.
     std::string result;
-    result.reserve (zeroes + (b256.end() - iter));
+    result.reserve (zeroes + used * 4);
     result.assign (zeroes, 0x00);
-    while (iter != b256.end())
-        result.push_back(*(iter++));
+    for (auto i = used; i-- != 0;)
+    {
+        auto const v = limbs[i];
+        auto shift = 24;
+        if (i == used - 1)
+            while ((v >> shift) == 0)
+                shift -= 8;
+        for (; shift >= 0; shift -= 8)
+            result.push_back(static_cast<char>(v >> shift));
+    }
     return result;
 }
 
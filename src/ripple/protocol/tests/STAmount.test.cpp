@@ -466,6 +466,86 @@ public:
 
     //--------------------------------------------------------------------------
 
+    // Compute (value * mul + add) / div the way STAmount used to
+    static std::uint64_t bigMulDiv (std::uint64_t value,
+        std::uint64_t mul, std::uint64_t add, std::uint64_t div)
+    {
+        CBigNum v;
+        BN_add_word64 (&v, value);
+        BN_mul_word64 (&v, mul);
+        BN_add_word64 (&v, add);
+        BN_div_word64 (&v, div);
+        return v.getuint64 ();
+    }
+
+    // The mantissa adjustment mulRound and divRound make when rounding up
+    static STAmount roundUp (std::uint64_t value, int offset)
+    {
+        if (value > STAmount::cMaxValue)
+        {
+            while (value > (10 * STAmount::cMaxValue))
+            {
+                value /= 10;
+                ++offset;
+            }
+            value += 9;
+            value /= 10;
+            ++offset;
+        }
+        return STAmount (noIssue(), value, offset);
+    }
+
+    void testBigNumParity ()
+    {
+        testcase ("bignum parity");
+
+        std::uint64_t const tenTo14 = 100000000000000ull;
+        std::uint64_t const tenTo17 = tenTo14 * 1000;
+
+        auto const random = []
+        {
+            return STAmount (noIssue(),
+                rand_int (STAmount::cMinValue, STAmount::cMaxValue),
+                    rand_int (-30, 30));
+        };
+
+        for (int i = 0; i < 100000; ++i)
+        {
+            auto const a = random ();
+            auto const b = random ();
+            auto const m1 = a.mantissa ();
+            auto const m2 = b.mantissa ();
+            auto const e1 = a.exponent ();
+            auto const e2 = b.exponent ();
+
+            expect (multiply (a, b, noIssue()) == STAmount (noIssue(),
+                bigMulDiv (m1, m2, 0, tenTo14) + 7, e1 + e2 + 14));
+            expect (divide (a, b, noIssue()) == STAmount (noIssue(),
+                bigMulDiv (m1, tenTo17, 0, m2) + 5, e1 - e2 - 17));
+
+            expect (mulRound (a, b, noIssue(), false) == STAmount (noIssue(),
+                bigMulDiv (m1, m2, 0, tenTo14), e1 + e2 + 14));
+            expect (divRound (a, b, noIssue(), false) == STAmount (noIssue(),
+                bigMulDiv (m1, tenTo17, 0, m2), e1 - e2 - 17));
+
+            // Results below the smallest representable value
+            // round up to it, which the reference does not model.
+            auto const up1 = mulRound (a, b, noIssue(), true);
+            if (up1 != STAmount (noIssue(),
+                    STAmount::cMinValue, STAmount::cMinOffset))
+                expect (up1 == roundUp (bigMulDiv (
+                    m1, m2, tenTo14 - 1, tenTo14), e1 + e2 + 14));
+
+            auto const up2 = divRound (a, b, noIssue(), true);
+            if (up2 != STAmount (noIssue(),
+                    STAmount::cMinValue, STAmount::cMinOffset))
+                expect (up2 == roundUp (bigMulDiv (
+                    m1, tenTo17, m2 - 1, m2), e1 - e2 - 17));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
     void testUnderflow ()
     {
         testcase ("underflow");
@@ -636,6 +716,7 @@ public:
         testNativeCurrency ();
         testCustomCurrency ();
         testArithmetic ();
+        testBigNumParity ();
         testUnderflow ();
         testRounding ();
         testConvertXRP ();
@@ -19,16 +19,59 @@
 
 #include <BeastConfig.h>
 #include <ripple/basics/Log.h>
+#include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/SecretKey.h>
 #include <ripple/protocol/st.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/json/to_string.h>
 #include <ripple/beast/unit_test.h>
+#include <chrono>
 #include <memory>
 #include <type_traits>
 
 namespace ripple {
 
+namespace detail {
+
+// An object of the given format with every required and
+// optional field present
+inline
+STObject
+makeFullObject (SOTemplate const& type)
+{
+    STObject obj (type, sfLedgerEntry);
+    for (auto const& e : type.all())
+        if (e->flags == SOE_OPTIONAL)
+            obj.makeFieldPresent (e->e_field);
+    return obj;
+}
+
+// The same fields in an object without a template
+inline
+STObject
+makeFreeObject (STObject const& obj)
+{
+    STObject free (sfLedgerEntry);
+    for (auto const& field : obj)
+        if (field.getSType() != STI_NOTPRESENT)
+            free.emplace_back (field);
+    return free;
+}
+
+template <class Formats, class Function>
+void
+forEachFormat (Formats const& formats, Function&& f)
+{
+    for (int t = 0; t < 256; ++t)
+    {
+        using Type = decltype (formats.findTypeByName (""));
+        if (auto const item = formats.findByType (static_cast<Type> (t)))
+            f (*item);
+    }
+}
+
+} // detail
+
 class STObject_test : public beast::unit_test::suite
 {
 public:
@@ -474,9 +517,103 @@ public:
         }
     }
 
+    template <class Formats>
+    void
+    testTemplateEncoding (Formats const& formats)
+    {
+        detail::forEachFormat (formats, [&](typename Formats::Item const& item)
+        {
+            auto const obj = detail::makeFullObject (item.elements);
+            auto const free = detail::makeFreeObject (obj);
+
+            Serializer s1, s2;
+            obj.add (s1);
+            free.add (s2);
+            expect (s1 == s2, item.getName());
+
+            Serializer u1, u2;
+            obj.addWithoutSigningFields (u1);
+            free.addWithoutSigningFields (u2);
+            expect (u1 == u2, item.getName());
+
+            STObject parsed (SerialIter{s1.slice()}, sfLedgerEntry);
+            expect (parsed.setType (item.elements), item.getName());
+            expect (parsed.getSerializer() == s1, item.getName());
+        });
+    }
+
+    void
+    testSetType ()
+    {
+        testcase ("set type");
+
+        auto const& format =
+            LedgerFormats::getInstance().findByType (ltACCOUNT_ROOT)->elements;
+
+        // Fields arrive in any order and land in template order
+        STObject obj (sfLedgerEntry);
+        obj.setFieldU32 (sfSequence, 7);
+        obj.setFieldU16 (sfLedgerEntryType, ltACCOUNT_ROOT);
+        obj.setAccountID (sfAccount, AccountID{});
+        obj.setFieldAmount (sfBalance, STAmount{});
+        obj.setFieldU32 (sfOwnerCount, 0);
+        obj.setFieldH256 (sfPreviousTxnID, uint256{});
+        obj.setFieldU32 (sfPreviousTxnLgrSeq, 0);
+        obj.setFieldU32 (sfFlags, 0);
+        expect (obj.setType (format));
+        expect (obj.isValidForType ());
+        expect (obj.getFieldU32 (sfSequence) == 7);
+
+        // A missing required field
+        STObject missing (sfLedgerEntry);
+        missing.setFieldU32 (sfSequence, 7);
+        expect (! missing.setType (format));
+
+        // A field the template doesn't allow
+        STObject extra (detail::makeFreeObject (
+            detail::makeFullObject (format)));
+        extra.setFieldU32 (sfOfferSequence, 1);
+        expect (! extra.setType (format));
+    }
+
+    void
+    testScratchSerializer ()
+    {
+        testcase ("scratch serializer");
+
+        auto const obj = detail::makeFullObject (LedgerFormats::getInstance().
+            findByType (ltACCOUNT_ROOT)->elements);
+        Serializer s;
+        s.add32 (HashPrefix::leafNode);
+        obj.add (s);
+        auto const expected = s.getSHA512Half ();
+
+        std::size_t capacity;
+        {
+            ScratchSerializer outer;
+            outer.addRaw (s);
+            capacity = outer.capacity ();
+
+            // A nested use gets a buffer of its own
+            expect (obj.getHash (HashPrefix::leafNode) == expected);
+            expect (outer == s);
+        }
+        {
+            ScratchSerializer reused;
+            expect (reused.size () == 0);
+            expect (reused.capacity () >= capacity);
+        }
+        expect (obj.getHash (HashPrefix::leafNode) == expected);
+    }
+
     void
     run()
     {
+        testScratchSerializer ();
+        testcase ("template encoding");
+        testTemplateEncoding (LedgerFormats::getInstance());
+        testTemplateEncoding (TxFormats::getInstance());
+        testSetType();
         testFields();
         testSerialization();
         testParseJSONArray();
@@ -484,6 +621,141 @@ public:
     }
 };
 
+// Serialize and parse throughput for each ledger entry type
+class STObject_timing_test : public beast::unit_test::suite
+{
+public:
+    template <class F>
+    std::chrono::duration<double>
+    timed (F&& f)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::steady_clock::now() - start;
+    }
+
+    void
+    testSerialize ()
+    {
+        testcase ("serialize");
+
+        using namespace std::chrono;
+        int const n = 100000;
+        std::size_t sink = 0;
+
+        detail::forEachFormat (LedgerFormats::getInstance(),
+            [&](LedgerFormats::Item const& item)
+        {
+            auto const obj = detail::makeFullObject (item.elements);
+            auto const free = detail::makeFreeObject (obj);
+            auto const data = obj.getSerializer();
+
+            auto const templated = timed ([&]
+            {
+                for (int i = 0; i < n; ++i)
+                    sink += obj.getSerializer().size();
+            });
+            auto const sorted = timed ([&]
+            {
+                for (int i = 0; i < n; ++i)
+                    sink += free.getSerializer().size();
+            });
+            auto const parse = timed ([&]
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    STObject parsed (SerialIter{data.slice()}, sfLedgerEntry);
+                    sink += parsed.setType (item.elements);
+                }
+            });
+            log << item.getName() << " (" << data.size() << " bytes): " <<
+                "serialize " << duration_cast<milliseconds>(templated).count() <<
+                "ms, untemplated " << duration_cast<milliseconds>(sorted).count() <<
+                "ms, parse " << duration_cast<milliseconds>(parse).count() <<
+                "ms";
+        });
+        pass ();
+        expect (sink != 0);
+    }
+
+    // The work done for a submit or sign request with tx_json
+    void
+    testParseJSON ()
+    {
+        testcase ("parse json");
+
+        using namespace std::chrono;
+        int const n = 50000;
+        std::size_t sink = 0;
+
+        AccountID account, destination, issuer;
+        account.begin()[0] = 1;
+        destination.begin()[0] = 2;
+        issuer.begin()[0] = 3;
+
+        std::string const text =
+            "{\"Account\":\"" + toBase58 (account) + "\","
+            "\"Amount\":{\"currency\":\"USD\",\"issuer\":\"" +
+                toBase58 (issuer) + "\",\"value\":\"1.5\"},"
+            "\"Destination\":\"" + toBase58 (destination) + "\","
+            "\"Fee\":\"10\",\"Flags\":2147483648,"
+            "\"LastLedgerSequence\":1000,"
+            "\"Memos\":[{\"Memo\":{\"MemoData\":\"ABCD\","
+                "\"MemoType\":\"0102\"}}],"
+            "\"Sequence\":42,"
+            "\"SigningPubKey\":\"02" + std::string (64, 'A') + "\","
+            "\"TransactionType\":\"Payment\","
+            "\"TxnSignature\":\"30" + std::string (140, 'B') + "\"}";
+
+        Json::Value json;
+        if (! expect (parseJSONString (text, json)))
+            return;
+        STParsedJSONObject const parsed ("tx_json", json);
+        if (! expect (parsed.object != boost::none))
+            return;
+
+        auto const fromDOM = timed ([&]
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                STParsedJSONObject const p ("tx_json", json);
+                sink += p.object->getCount();
+            }
+        });
+        auto const fromText = timed ([&]
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                Json::Value v;
+                parseJSONString (text, v);
+                STParsedJSONObject const p ("tx_json", v);
+                sink += p.object->getCount();
+            }
+        });
+        log << "Payment: " <<
+            n * 1.0 / duration<double>(fromDOM).count() <<
+                "/s from Json::Value, " <<
+            n * 1.0 / duration<double>(fromText).count() <<
+                "/s from text";
+        expect (sink != 0);
+    }
+
+    bool
+    parseJSONString (std::string const& json, Json::Value& to)
+    {
+        Json::Reader reader;
+        return reader.parse (json, to) && to.isObject();
+    }
+
+    void
+    run () override
+    {
+        testSerialize ();
+        testParseJSON ();
+    }
+};
+
 BEAST_DEFINE_TESTSUITE(STObject,protocol,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(STObject_timing,protocol,ripple);
 
 } // ripple
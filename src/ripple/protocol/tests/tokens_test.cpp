@@ -0,0 +1,311 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/protocol/tokens.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace ripple {
+
+namespace detail {
+
+static char const* const refAlphabet =
+    "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz";
+
+// The byte at a time codec this one replaced, from Bitcoin:
+// https://github.com/bitcoin/bitcoin
+// Copyright (c) 2014 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// The byte at a time encoder this codec replaced
+static
+std::string
+refEncodeBase58 (std::vector<unsigned char> const& v)
+{
+    auto pbegin = v.begin();
+    int zeroes = 0;
+    while (pbegin != v.end() && *pbegin == 0)
+    {
+        ++pbegin;
+        ++zeroes;
+    }
+    std::vector<unsigned char> b58 (v.size() * 2 + 1);
+    for (; pbegin != v.end(); ++pbegin)
+    {
+        int carry = *pbegin;
+        for (auto iter = b58.rbegin(); iter != b58.rend(); ++iter)
+        {
+            carry += 256 * (*iter);
+            *iter = carry % 58;
+            carry /= 58;
+        }
+    }
+    auto iter = std::find_if (b58.begin(), b58.end(),
+        [](unsigned char c) { return c != 0; });
+    std::string str (zeroes, refAlphabet[0]);
+    while (iter != b58.end())
+        str += refAlphabet[*(iter++)];
+    return str;
+}
+
+// The byte at a time decoder this codec replaced
+static
+std::string
+refDecodeBase58 (std::string const& s)
+{
+    auto const digit = [](char c)
+    {
+        auto const p = std::strchr (refAlphabet, c);
+        return (c == 0 || p == nullptr) ? -1 : int(p - refAlphabet);
+    };
+    auto psz = s.begin();
+    int zeroes = 0;
+    while (psz != s.end() && digit (*psz) == 0)
+    {
+        ++zeroes;
+        ++psz;
+    }
+    std::vector<unsigned char> b256 (s.size() * 733 / 1000 + 1);
+    for (; psz != s.end(); ++psz)
+    {
+        auto carry = digit (*psz);
+        if (carry == -1)
+            return {};
+        for (auto iter = b256.rbegin(); iter != b256.rend(); ++iter)
+        {
+            carry += 58 * *iter;
+            *iter = carry % 256;
+            carry /= 256;
+        }
+    }
+    auto iter = std::find_if (b256.begin(), b256.end(),
+        [](unsigned char c) { return c != 0; });
+    std::string result (zeroes, 0x00);
+    while (iter != b256.end())
+        result.push_back (*(iter++));
+    return result;
+}
+
+static
+std::vector<unsigned char>
+refExpand (std::uint8_t type, std::vector<unsigned char> const& token)
+{
+    std::vector<unsigned char> v;
+    v.push_back (type);
+    v.insert (v.end(), token.begin(), token.end());
+    sha256_hasher h1;
+    h1 (v.data(), v.size());
+    auto const d1 = static_cast<sha256_hasher::result_type>(h1);
+    sha256_hasher h2;
+    h2 (d1.data(), d1.size());
+    auto const d2 = static_cast<sha256_hasher::result_type>(h2);
+    v.insert (v.end(), d2.data(), d2.data() + 4);
+    return v;
+}
+
+static
+std::string
+refDecodeToken (std::string const& s, std::uint8_t type)
+{
+    auto const v = refDecodeBase58 (s);
+    if (v.size() < 6 || std::uint8_t(v[0]) != type)
+        return {};
+    auto const token = std::vector<unsigned char> (
+        v.begin() + 1, v.end() - 4);
+    auto const expanded = refExpand (type, token);
+    if (std::string (expanded.begin(), expanded.end()) != v)
+        return {};
+    return std::string (token.begin(), token.end());
+}
+
+} // detail
+
+class tokens_test : public beast::unit_test::suite
+{
+public:
+    beast::xor_shift_engine engine_ {42};
+
+    std::vector<unsigned char>
+    randomToken (std::size_t size)
+    {
+        std::vector<unsigned char> v (size);
+        // Leading zero bytes exercise the digit/byte zero mapping
+        auto const zeroes = std::uniform_int_distribution<
+            std::size_t>(0, 3)(engine_);
+        for (std::size_t i = 0; i < size; ++i)
+            v[i] = (i < zeroes) ? 0 :
+                std::uniform_int_distribution<int>(0, 255)(engine_);
+        return v;
+    }
+
+    void
+    testEquivalence ()
+    {
+        testcase ("equivalence");
+
+        std::uint8_t const types[] = {
+            TOKEN_ACCOUNT_ID, TOKEN_NODE_PUBLIC, TOKEN_ACCOUNT_PUBLIC,
+            TOKEN_FAMILY_SEED, TOKEN_NONE };
+
+        std::size_t failures = 0;
+        for (int i = 0; i < 20000; ++i)
+        {
+            auto const type = types[i % 5];
+            auto const size = (i % 3 == 0) ? 20 : (i % 3 == 1) ? 33 :
+                std::uniform_int_distribution<
+                    std::size_t>(0, 80)(engine_);
+            auto const token = randomToken (size);
+            auto const encoded = base58EncodeToken (
+                type, token.data(), token.size());
+            auto const expected = detail::refEncodeBase58 (
+                detail::refExpand (type, token));
+            if (encoded != expected)
+                ++failures;
+
+            auto const decoded = decodeBase58Token (encoded, type);
+            if (size > 0 &&
+                decoded != std::string (token.begin(), token.end()))
+                ++failures;
+
+            // Corrupted input must be handled the same way
+            auto bad = encoded;
+            auto const pos = std::uniform_int_distribution<
+                std::size_t>(0, bad.size() - 1)(engine_);
+            bad[pos] = "r1x0lO"[i % 6];
+            if (decodeBase58Token (bad, type) !=
+                    detail::refDecodeToken (bad, type))
+                ++failures;
+        }
+        expect (failures == 0, std::to_string (failures) + " mismatches");
+    }
+
+    void
+    testKnown ()
+    {
+        testcase ("known values");
+
+        expect (toBase58 (AccountID{}) ==
+            "rrrrrrrrrrrrrrrrrrrrrhoLvTp");
+        expect (toBase58 (AccountID(1)) ==
+            "rrrrrrrrrrrrrrrrrrrrBZbvji");
+        expect (parseBase58<AccountID> (
+            "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh") != boost::none);
+
+        // Bad characters, wrong type and checksum errors
+        expect (! parseBase58<AccountID> ("rHb9CJAWyB4rj91VRWn96DkukG4bwdtyT0"));
+        expect (! parseBase58<AccountID> ("rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTi"));
+        expect (decodeBase58Token ("", TOKEN_ACCOUNT_ID).empty());
+        expect (decodeBase58Token ("rrrrrr", TOKEN_ACCOUNT_ID).empty());
+    }
+
+    void
+    run () override
+    {
+        testKnown ();
+        testEquivalence ();
+    }
+};
+
+// Compares throughput against the previous implementation
+class tokens_timing_test : public beast::unit_test::suite
+{
+public:
+    template <class F>
+    std::chrono::duration<double>
+    timed (F&& f)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::steady_clock::now() - start;
+    }
+
+    void
+    run () override
+    {
+        using namespace std::chrono;
+        int const n = 200000;
+        std::vector<AccountID> ids;
+        beast::xor_shift_engine engine;
+        for (int i = 0; i < 1000; ++i)
+        {
+            AccountID id;
+            for (auto& b : id)
+                b = std::uniform_int_distribution<int>(0, 255)(engine);
+            ids.push_back (id);
+        }
+
+        std::size_t sink = 0;
+        auto const fast = timed ([&]
+        {
+            for (int i = 0; i < n; ++i)
+                sink += toBase58 (ids[i % ids.size()]).size();
+        });
+        auto const ref = timed ([&]
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                auto const& id = ids[i % ids.size()];
+                sink += detail::refEncodeBase58 (detail::refExpand (
+                    TOKEN_ACCOUNT_ID, std::vector<unsigned char>(
+                        id.begin(), id.end()))).size();
+            }
+        });
+        log << "encode: " << duration_cast<milliseconds>(fast).count() <<
+            "ms, reference: " << duration_cast<milliseconds>(ref).count() <<
+            "ms";
+
+        std::vector<std::string> strs;
+        for (auto const& id : ids)
+            strs.push_back (toBase58 (id));
+        auto const fastDecode = timed ([&]
+        {
+            for (int i = 0; i < n; ++i)
+                sink += decodeBase58Token (
+                    strs[i % strs.size()], TOKEN_ACCOUNT_ID).size();
+        });
+        auto const refDecode = timed ([&]
+        {
+            for (int i = 0; i < n; ++i)
+                sink += detail::refDecodeBase58 (
+                    strs[i % strs.size()]).size();
+        });
+        log << "decode: " <<
+            duration_cast<milliseconds>(fastDecode).count() <<
+            "ms, reference: " <<
+            duration_cast<milliseconds>(refDecode).count() << "ms";
+        pass ();
+        expect (sink != 0);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(tokens,protocol,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(tokens_timing,protocol,ripple);
+
+} // ripple
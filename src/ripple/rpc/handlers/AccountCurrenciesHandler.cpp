@@ -18,7 +18,8 @@
 //==============================================================================
 
 #include <BeastConfig.h>
-#include <ripple/app/paths/RippleState.h>
+#include <ripple/app/paths/PathRequests.h>
+#include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/protocol/JsonFields.h>
 #include <ripple/rpc/Context.h>
@@ -53,21 +54,16 @@ Json::Value doAccountCurrencies (RPC::Context& context)
     if (auto jvAccepted = RPC::accountFromString (accountID, strIdent, bStrict))
         return jvAccepted;
 
-    std::set<Currency> send, receive;
-    for (auto const& item : getRippleStateItems (accountID, *ledger))
-    {
-        auto const rspEntry = item.get();
+    // Gateways have many lines, the trust line graph keeps
+    // their currencies if it follows this ledger.
+    RippleLineCache cache (ledger,
+        context.app.getPathRequests().getTrustLineGraph());
+    auto const& currencies = cache.getCurrencies (accountID);
 
-        STAmount const& saBalance = rspEntry->getBalance ();
-
-        if (saBalance < rspEntry->getLimit ())
-            receive.insert (saBalance.getCurrency ());
-        if ((-saBalance) < rspEntry->getLimitPeer ())
-            send.insert (saBalance.getCurrency ());
-    }
-
-    send.erase (badCurrency());
-    receive.erase (badCurrency());
+    std::set<Currency> const send (
+        currencies.source.begin (), currencies.source.end ());
+    std::set<Currency> const receive (
+        currencies.destination.begin (), currencies.destination.end ());
 
     Json::Value& sendCurrencies =
             (result[jss::send_currencies] = Json::arrayValue);
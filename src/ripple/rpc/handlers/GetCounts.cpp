@@ -21,8 +21,10 @@
 #include <ripple/app/ledger/AcceptedLedger.h>
 #include <ripple/app/ledger/InboundLedgers.h>
 #include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/app/paths/PathRequests.h>
 #include <ripple/basics/UptimeTimer.h>
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/json/json_value.h>
@@ -105,6 +107,12 @@ Json::Value doGetCounts (RPC::Context& context)
     ret[jss::node_hit_rate] = context.app.getNodeStore ().getCacheHitRate ();
     ret[jss::ledger_hit_rate] = context.app.getLedgerMaster ().getCacheHitRate ();
     ret[jss::AL_hit_rate] = context.app.getAcceptedLedgerCache ().getHitRate ();
+    ret[jss::path_hit_rate] =
+        context.app.getPathRequests ().getPathCache ().getHitRate ();
+    ret[jss::STTx_hit_rate] =
+        context.app.getMasterTransaction ().getParsedCache ().getHitRate ();
+    ret[jss::STTx_cache_size] =
+        context.app.getMasterTransaction ().getParsedCache ().getCacheSize ();
 
     ret[jss::fullbelow_size] = static_cast<int>(context.app.family().fullbelow().size());
     ret[jss::treenode_cache_size] = context.app.family().treecache().getCacheSize();
@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/basics/StringUtilities.h>
+#include <ripple/net/RPCErr.h>
+#include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/JsonFields.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/rpc/impl/LookupLedger.h>
+#include <ripple/rpc/impl/Tuning.h>
+#include <ripple/rpc/Context.h>
+#include <ripple/server/Role.h>
+
+namespace ripple {
+
+// Get the state nodes that differ between two closed ledgers
+//   Inputs:
+//     ledger_hash:        later ledger's hash, or
+//     ledger_index:       later ledger's index
+//     base_ledger_hash:   earlier ledger's hash, or
+//     base_ledger_index:  earlier ledger's index
+//     limit:              integer, maximum number of entries
+//     marker:             opaque, resume point
+//     binary:             boolean, format
+//   Outputs:
+//     ledger_hash:        later ledger's hash
+//     ledger_index:       later ledger's index
+//     base_ledger_hash:   earlier ledger's hash
+//     base_ledger_index:  earlier ledger's index
+//     diff:               array of changed state nodes, each with the
+//                         entry in the earlier ledger (previous) and in
+//                         the later ledger (current), when present
+//     marker:             resume point, if any
+Json::Value doLedgerDiff (RPC::Context& context)
+{
+    auto const& params = context.params;
+
+    if (! params.isMember (jss::base_ledger_hash) &&
+        ! params.isMember (jss::base_ledger_index))
+        return RPC::missing_field_error (jss::base_ledger_index);
+
+    std::shared_ptr<ReadView const> view;
+    auto jvResult = RPC::lookupLedger (view, context);
+    if (! view)
+        return jvResult;
+
+    // Look up the base ledger from its own fields
+    std::shared_ptr<ReadView const> baseView;
+    {
+        RPC::Context baseContext (context);
+        baseContext.params = Json::objectValue;
+
+        if (params.isMember (jss::base_ledger_hash))
+            baseContext.params[jss::ledger_hash] = params[jss::base_ledger_hash];
+        if (params.isMember (jss::base_ledger_index))
+            baseContext.params[jss::ledger_index] = params[jss::base_ledger_index];
+
+        auto jvBase = RPC::lookupLedger (baseView, baseContext);
+        if (! baseView)
+            return jvBase;
+    }
+
+    auto const ledger = std::dynamic_pointer_cast<Ledger const> (view);
+    auto const baseLedger = std::dynamic_pointer_cast<Ledger const> (baseView);
+    if (! ledger || ! baseLedger || ledger->open () || baseLedger->open ())
+        return RPC::make_param_error ("Both ledgers must be closed.");
+
+    boost::optional<uint256> marker;
+    if (params.isMember (jss::marker))
+    {
+        Json::Value const& jMarker = params[jss::marker];
+        marker.emplace ();
+        if (! (jMarker.isString () && marker->SetHex (jMarker.asString ())))
+            return RPC::expected_field_error (jss::marker, "valid");
+    }
+
+    bool isBinary = params[jss::binary].asBool();
+
+    int limit = -1;
+    if (params.isMember (jss::limit))
+    {
+        Json::Value const& jLimit = params[jss::limit];
+        if (!jLimit.isIntegral ())
+            return RPC::expected_field_error (jss::limit, "integer");
+
+        limit = jLimit.asInt ();
+    }
+
+    auto maxLimit = RPC::Tuning::pageLength(isBinary);
+    if ((limit < 0) || ((limit > maxLimit) && (! isUnlimited (context.role))))
+        limit = maxLimit;
+
+    jvResult[jss::base_ledger_hash] = to_string (baseLedger->info().hash);
+    jvResult[jss::base_ledger_index] = baseLedger->info().seq;
+
+    Json::Value& nodes = (jvResult[jss::diff] = Json::arrayValue);
+
+    auto const render = [isBinary](SHAMapItem const& item)
+    {
+        if (isBinary)
+            return Json::Value (strHex (item.peekData ()));
+
+        return SLE (SerialIter (item.slice ()), item.key ()).getJson (0);
+    };
+
+    baseLedger->stateMap().visitDelta (ledger->stateMap(), marker,
+        [&](std::shared_ptr<SHAMapItem const> const& previous,
+            std::shared_ptr<SHAMapItem const> const& current)
+        {
+            auto k = previous ? previous->key () : current->key ();
+
+            if (limit-- <= 0)
+            {
+                // Stop processing before the current key.
+                jvResult[jss::marker] = to_string (--k);
+                return false;
+            }
+
+            Json::Value& entry = nodes.append (Json::objectValue);
+            entry[jss::index] = to_string (k);
+
+            if (previous)
+                entry[jss::previous] = render (*previous);
+            if (current)
+                entry[jss::current] = render (*current);
+
+            return true;
+        });
+
+    return jvResult;
+}
+
+} // ripple
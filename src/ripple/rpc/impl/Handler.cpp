@@ -123,6 +123,7 @@ Handler handlerArray[] {
     {   "ledger_closed",        byRef (&doLedgerClosed),        Role::USER,  NO_CONDITION   },
     {   "ledger_current",       byRef (&doLedgerCurrent),       Role::USER,  NEEDS_CURRENT_LEDGER  },
     {   "ledger_data",          byRef (&doLedgerData),          Role::USER,  NO_CONDITION  },
+    {   "ledger_diff",          byRef (&doLedgerDiff),          Role::ADMIN,   NO_CONDITION     },
     {   "ledger_entry",         byRef (&doLedgerEntry),         Role::USER,  NO_CONDITION  },
     {   "ledger_header",        byRef (&doLedgerHeader),        Role::USER,  NO_CONDITION  },
     {   "ledger_request",       byRef (&doLedgerRequest),       Role::ADMIN,   NO_CONDITION     },
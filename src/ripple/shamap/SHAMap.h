@@ -33,6 +33,7 @@
 #include <ripple/nodestore/Database.h>
 #include <ripple/nodestore/NodeObject.h>
 #include <ripple/beast/utility/Journal.h>
+#include <boost/optional.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/shared_lock_guard.hpp>
 #include <boost/thread/shared_mutex.hpp>
@@ -92,6 +93,9 @@ public:
     using DeltaItem = std::pair<std::shared_ptr<SHAMapItem const>,
                                 std::shared_ptr<SHAMapItem const>>;
     using Delta     = std::map<uint256, DeltaItem>;
+    using DeltaVisitor = std::function<bool (
+        std::shared_ptr<SHAMapItem const> const&,
+        std::shared_ptr<SHAMapItem const> const&)>;
 
     ~SHAMap ();
     SHAMap(SHAMap const&) = delete;
@@ -175,6 +179,12 @@ public:
         std::size_t max,
         SHAMapSyncFilter *filter);
 
+    std::vector<std::pair<SHAMapNodeID, uint256>>
+    getMissingNodes (
+        std::size_t max,
+        SHAMapSyncFilter *filter,
+        beast::Journal journal);
+
     bool getNodeFat (SHAMapNodeID node,
         std::vector<SHAMapNodeID>& nodeIDs,
             std::vector<Blob>& rawNode,
@@ -199,6 +209,23 @@ public:
     bool compare (SHAMap const& otherMap,
                   Delta& differences, int maxCount) const;
 
+    /** Visit the items that differ between this map and another.
+
+        Differences are visited in key order, starting after `marker`
+        when one is given. Branches with matching hashes are skipped and
+        nothing is accumulated, so memory use is bounded by the depth of
+        the maps rather than the number of differences. The visitor gets
+        the item from this map and the item from the other map, either of
+        which may be null, and returns `false` to stop the walk.
+
+        @return `true` if every difference was visited.
+
+        CAUTION: otherMap is not locked and must be immutable
+    */
+    bool visitDelta (SHAMap const& otherMap,
+        boost::optional<uint256> const& marker,
+            DeltaVisitor const& visitor) const;
+
     int flushDirty (NodeObjectType t, std::uint32_t seq);
     void walkMap (std::vector<SHAMapMissingNode>& missingNodes, int maxMissing) const;
     bool deepCompare (SHAMap & other) const;  // Intended for debug/test only
@@ -272,10 +299,6 @@ private:
     std::shared_ptr<SHAMapAbstractNode> descend (std::shared_ptr<SHAMapInnerNode> const&, int branch) const;
     std::shared_ptr<SHAMapAbstractNode> descendThrow (std::shared_ptr<SHAMapInnerNode> const&, int branch) const;
 
-    // Descend with filter
-    SHAMapAbstractNode* descendAsync (SHAMapInnerNode* parent, int branch,
-        SHAMapSyncFilter* filter, bool& pending) const;
-
     std::pair <SHAMapAbstractNode*, SHAMapNodeID>
         descend (SHAMapInnerNode* parent, SHAMapNodeID const& parentID,
         int branch, SHAMapSyncFilter* filter) const;
@@ -297,6 +320,7 @@ private:
                      std::shared_ptr<SHAMapItem const> const& otherMapItem,
                      bool isFirstMap, Delta & differences, int & maxCount) const;
     int walkSubTree (bool doWrite, NodeObjectType t, std::uint32_t seq);
+    void hashDirtyLeaves () const;
 };
 
 inline
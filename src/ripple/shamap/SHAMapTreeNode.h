@@ -210,6 +210,15 @@ public:  // public only to SHAMap
 
     std::string getString (SHAMapNodeID const&) const override;
     bool updateHash () override;
+
+    /** Update the hashes of several leaves.
+
+        This is equivalent to calling updateHash on each,
+        but the digests are computed side by side.
+    */
+    static
+    void
+    updateHashes (SHAMapTreeNode* const* nodes, std::size_t count);
 };
 
 // SHAMapAbstractNode
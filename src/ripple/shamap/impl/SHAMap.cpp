@@ -334,49 +334,6 @@ SHAMap::descend (SHAMapInnerNode * parent, SHAMapNodeID const& parentID,
     return std::make_pair (child, childID);
 }
 
-SHAMapAbstractNode*
-SHAMap::descendAsync (SHAMapInnerNode* parent, int branch,
-    SHAMapSyncFilter * filter, bool & pending) const
-{
-    pending = false;
-
-    SHAMapAbstractNode* ret = parent->getChildPointer (branch);
-    if (ret)
-        return ret;
-
-    auto const& hash = parent->getChildHash (branch);
-
-    std::shared_ptr<SHAMapAbstractNode> ptr = getCache (hash);
-    if (!ptr)
-    {
-        if (filter)
-            ptr = checkFilter (hash, filter);
-
-        if (!ptr && backed_)
-        {
-            std::shared_ptr<NodeObject> obj;
-            if (! f_.db().asyncFetch (hash.as_uint256(), obj))
-            {
-                pending = true;
-                return nullptr;
-            }
-            if (!obj)
-                return nullptr;
-
-            ptr = SHAMapAbstractNode::make(
-                obj->getData(), 0, snfPREFIX, hash, true, f_.journal ());
-
-            if (ptr && backed_)
-                canonicalize (hash, ptr);
-        }
-    }
-
-    if (ptr)
-        ptr = parent->canonicalizeChild (branch, std::move(ptr));
-
-    return ptr.get ();
-}
-
 template <class Node>
 std::shared_ptr<Node>
 SHAMap::unshareNode (std::shared_ptr<Node> node, SHAMapNodeID const& nodeID)
@@ -867,7 +824,10 @@ SHAMap::writeNode (
 
     canonicalize (node->getNodeHash(), node);
 
-    Serializer s;
+    // The buffer is handed to the database, so size it to
+    // hold the whole node and allocate it just once
+    Serializer s (node->isInner () ? (4 + 16 * 32) :
+        (4 + 32 + static_cast<SHAMapTreeNode&>(*node).peekItem()->size()));
     node->addRaw (s, snfPREFIX);
     f_.db().store (t,
         std::move (s.modData ()), node->getNodeHash ().as_uint256());
@@ -907,6 +867,40 @@ int SHAMap::flushDirty (NodeObjectType t, std::uint32_t seq)
     return walkSubTree (true, t, seq);
 }
 
+// Hash the modified leaves we own in batches, so that independent
+// leaves share the vector unit. Inner nodes depend on their
+// children's hashes and are still hashed one at a time.
+void
+SHAMap::hashDirtyLeaves () const
+{
+    std::vector<SHAMapTreeNode*> leaves;
+    std::vector<SHAMapInnerNode*> stack;
+    stack.push_back (static_cast<SHAMapInnerNode*>(root_.get()));
+
+    while (! stack.empty ())
+    {
+        auto const node = stack.back();
+        stack.pop_back();
+
+        for (int branch = 0; branch < 16; ++branch)
+        {
+            if (node->isEmptyBranch (branch))
+                continue;
+
+            auto const child = node->getChildPointer (branch);
+            if (! child || (child->getSeq() == 0))
+                continue;
+
+            if (child->isInner ())
+                stack.push_back (static_cast<SHAMapInnerNode*>(child));
+            else if (child->getSeq() == seq_)
+                leaves.push_back (static_cast<SHAMapTreeNode*>(child));
+        }
+    }
+
+    SHAMapTreeNode::updateHashes (leaves.data(), leaves.size());
+}
+
 int
 SHAMap::walkSubTree (bool doWrite, NodeObjectType t, std::uint32_t seq)
 {
@@ -940,6 +934,8 @@ SHAMap::walkSubTree (bool doWrite, NodeObjectType t, std::uint32_t seq)
     using StackEntry = std::pair <std::shared_ptr<SHAMapInnerNode>, int>;
     std::stack <StackEntry, std::vector<StackEntry>> stack;
 
+    hashDirtyLeaves ();
+
     node = preFlushNode(std::move(node));
 
     int pos = 0;
@@ -964,6 +960,8 @@ SHAMap::walkSubTree (bool doWrite, NodeObjectType t, std::uint32_t seq)
                 {
                     // This is a node that needs to be flushed
 
+                    // Leaves we own were hashed by hashDirtyLeaves
+                    bool const hashed = (child->getSeq() == seq_);
                     child = preFlushNode(std::move(child));
 
                     if (child->isInner ())
@@ -981,7 +979,8 @@ SHAMap::walkSubTree (bool doWrite, NodeObjectType t, std::uint32_t seq)
                         ++flushed;
 
                         assert (node->getSeq() == seq_);
-                        child->updateHash();
+                        if (! hashed)
+                            child->updateHash();
 
                         if (doWrite && backed_)
                             child = writeNode(t, seq, std::move(child));
@@ -227,6 +227,138 @@ SHAMap::compare (SHAMap const& otherMap,
     return true;
 }
 
+bool
+SHAMap::visitDelta (SHAMap const& otherMap,
+    boost::optional<uint256> const& marker,
+        DeltaVisitor const& visitor) const
+{
+    // Walk both maps together in key order, descending only where the
+    // branch hashes differ. A leaf facing an inner node is treated as an
+    // inner node holding just that leaf, so it is reported in order with
+    // the contents of the other map's subtree.
+    // throws on missing nodes
+
+    assert (isValid () && otherMap.isValid ());
+
+    if (getHash () == otherMap.getHash ())
+        return true;
+
+    struct StackEntry
+    {
+        std::shared_ptr<SHAMapAbstractNode> ours;
+        std::shared_ptr<SHAMapAbstractNode> other;
+        SHAMapNodeID nodeID;
+        bool onMarkerPath;  // the marker is below this node
+    };
+
+    std::stack <StackEntry, std::vector<StackEntry>> nodeStack;
+    nodeStack.push ({root_, otherMap.root_, SHAMapNodeID (),
+        static_cast<bool>(marker)});
+
+    auto const report = [&](
+        std::shared_ptr<SHAMapItem const> const& ours,
+        std::shared_ptr<SHAMapItem const> const& other)
+    {
+        // Skip whatever was visited before the marker
+        auto const& key = ours ? ours->key () : other->key ();
+        if (marker && (key <= *marker))
+            return true;
+
+        return visitor (ours, other);
+    };
+
+    auto const childOf = [](SHAMap const& map,
+        std::shared_ptr<SHAMapAbstractNode> const& node,
+            SHAMapNodeID const& nodeID, int branch)
+    {
+        std::shared_ptr<SHAMapAbstractNode> child;
+
+        if (!node)
+            return child;
+
+        if (node->isLeaf ())
+        {
+            auto const& item =
+                static_cast<SHAMapTreeNode*>(node.get ())->peekItem ();
+            if (nodeID.selectBranch (item->key ()) == branch)
+                child = node;
+        }
+        else
+        {
+            auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+            if (!inner->isEmptyBranch (branch))
+                child = map.descendNoStore (inner, branch);
+        }
+
+        return child;
+    };
+
+    while (!nodeStack.empty ())
+    {
+        auto const entry = std::move (nodeStack.top ());
+        nodeStack.pop ();
+
+        auto const& ours = entry.ours;
+        auto const& other = entry.other;
+
+        if (ours && other && (ours->getNodeHash () == other->getNodeHash ()))
+            continue;
+
+        if ((!ours || ours->isLeaf ()) && (!other || other->isLeaf ()))
+        {
+            // two leaves, or a leaf and nothing
+            std::shared_ptr<SHAMapItem const> ourItem, otherItem;
+
+            if (ours)
+                ourItem = static_cast<SHAMapTreeNode*>(ours.get ())->peekItem ();
+            if (other)
+                otherItem = static_cast<SHAMapTreeNode*>(other.get ())->peekItem ();
+
+            if (ourItem && otherItem && (ourItem->key () == otherItem->key ()))
+            {
+                if (!report (ourItem, otherItem))
+                    return false;
+            }
+            else if (ourItem && (!otherItem || (ourItem->key () < otherItem->key ())))
+            {
+                if (!report (ourItem, nullptr))
+                    return false;
+                if (otherItem && !report (nullptr, otherItem))
+                    return false;
+            }
+            else
+            {
+                if (!report (nullptr, otherItem))
+                    return false;
+                if (ourItem && !report (ourItem, nullptr))
+                    return false;
+            }
+
+            continue;
+        }
+
+        // Branches ahead of the marker's branch hold nothing to report
+        int const first = entry.onMarkerPath ?
+            entry.nodeID.selectBranch (*marker) : 0;
+
+        // Push in reverse so that the lowest branch is visited first
+        for (int branch = 15; branch >= first; --branch)
+        {
+            auto ourChild = childOf (*this, ours, entry.nodeID, branch);
+            auto otherChild = childOf (otherMap, other, entry.nodeID, branch);
+
+            if (ourChild || otherChild)
+            {
+                nodeStack.push ({std::move (ourChild), std::move (otherChild),
+                    entry.nodeID.getChildNodeID (branch),
+                        entry.onMarkerPath && (branch == first)});
+            }
+        }
+    }
+
+    return true;
+}
+
 void SHAMap::walkMap (std::vector<SHAMapMissingNode>& missingNodes, int maxMissing) const
 {
     if (!root_->isInner ())  // root_ is only node, and we have it
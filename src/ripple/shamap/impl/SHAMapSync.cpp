@@ -22,6 +22,7 @@
 #include <ripple/shamap/SHAMap.h>
 #include <ripple/nodestore/Database.h>
 #include <ripple/beast/unit_test.h>
+#include <map>
 
 namespace ripple {
 
@@ -117,6 +118,21 @@ void SHAMap::visitNodes(std::function<bool (SHAMapAbstractNode&)> const& functio
 */
 std::vector<std::pair<SHAMapNodeID, uint256>>
 SHAMap::getMissingNodes(std::size_t max, SHAMapSyncFilter* filter)
+{
+    return getMissingNodes (max, filter, journal_);
+}
+
+/*  The map is traversed depth first without blocking. Children that are not
+    in memory, in the tree node cache or held by the filter are deferred, and
+    once the node store's preferred number of reads has been collected they
+    are resolved with a single batched read. The traversal then restarts from
+    the root and continues until nothing is deferred or enough missing nodes
+    have been found. Timings for each batch are reported to the supplied
+    journal.
+*/
+std::vector<std::pair<SHAMapNodeID, uint256>>
+SHAMap::getMissingNodes(std::size_t max, SHAMapSyncFilter* filter,
+    beast::Journal journal)
 {
     assert (root_->isValid ());
     assert (root_->getNodeHash().isNonZero ());
@@ -140,7 +156,8 @@ SHAMap::getMissingNodes(std::size_t max, SHAMapSyncFilter* filter)
         return ret;
     }
 
-    int const maxDefer = f_.db().getDesiredAsyncReadCount ();
+    std::size_t const maxDefer = std::max (1,
+        f_.db().getDesiredAsyncReadCount ());
 
     // Track the missing hashes we have found so far
     std::set <SHAMapHash> missingHashes;
@@ -148,16 +165,22 @@ SHAMap::getMissingNodes(std::size_t max, SHAMapSyncFilter* filter)
     // preallocate memory
     ret.reserve (max);
 
-    while (1)
+    while (ret.size () < max)
     {
-        std::vector <std::tuple <SHAMapInnerNode*, int, SHAMapNodeID>> deferredReads;
-        deferredReads.reserve (maxDefer + 16);
+        // A child waiting on the batched read
+        using Waiter = std::tuple <SHAMapInnerNode*, int, SHAMapNodeID>;
+
+        // Keyed by hash so the backend reads in key order, which is
+        // also how duplicates are coalesced into one read
+        std::map <SHAMapHash, std::vector<Waiter>> deferredReads;
 
         using StackEntry = std::tuple<SHAMapInnerNode*, SHAMapNodeID, int, int, bool>;
         std::stack <StackEntry, std::vector<StackEntry>> stack;
 
         // Traverse the map without blocking
 
+        auto const before = std::chrono::steady_clock::now();
+
         auto node = static_cast<SHAMapInnerNode*>(root_.get());
         SHAMapNodeID nodeID;
 
@@ -175,53 +198,65 @@ SHAMap::getMissingNodes(std::size_t max, SHAMapSyncFilter* filter)
             while (currentChild < 16)
             {
                 int branch = (firstChild + currentChild++) % 16;
-                if (!node->isEmptyBranch (branch))
+                if (node->isEmptyBranch (branch))
+                    continue;
+
+                auto const& childHash = node->getChildHash (branch);
+
+                if (missingHashes.count (childHash) != 0)
                 {
-                    auto const& childHash = node->getChildHash (branch);
+                    fullBelow = false;
+                    continue;
+                }
+
+                if (backed_ && f_.fullbelow().touch_if_exists (childHash.as_uint256()))
+                    continue;
 
-                    if (missingHashes.count (childHash) != 0)
+                SHAMapNodeID childID = nodeID.getChildNodeID (branch);
+                SHAMapAbstractNode* child = node->getChildPointer (branch);
+
+                if (!child)
+                {
+                    std::shared_ptr<SHAMapAbstractNode> ptr = getCache (childHash);
+
+                    if (!ptr && filter)
+                        ptr = checkFilter (childHash, filter);
+
+                    if (ptr)
+                        child = node->canonicalizeChild (branch, std::move(ptr)).get ();
+                }
+
+                if (!child)
+                {
+                    if (backed_)
                     {
-                        fullBelow = false;
+                        // read is deferred
+                        deferredReads[childHash].emplace_back (node, branch, childID);
                     }
-                    else if (! backed_ || ! f_.fullbelow().touch_if_exists (childHash.as_uint256()))
+                    else
                     {
-                        SHAMapNodeID childID = nodeID.getChildNodeID (branch);
-                        bool pending = false;
-                        auto d = descendAsync (node, branch, filter, pending);
+                        // node is not in the database
+                        missingHashes.insert (childHash);
+                        ret.emplace_back (childID, childHash.as_uint256());
 
-                        if (!d)
-                        {
-                            if (!pending)
-                            { // node is not in the database
-                                ret.emplace_back (
-                                    childID,
-                                    childHash.as_uint256());
-
-                                if (--max <= 0)
-                                    return ret;
-                            }
-                            else
-                            {
-                                // read is deferred
-                                deferredReads.emplace_back (node, branch, childID);
-                            }
-
-                            fullBelow = false; // This node is not known full below
-                        }
-                        else if (d->isInner() &&
-                                 !static_cast<SHAMapInnerNode*>(d)->isFullBelow(generation))
-                        {
-                            stack.push (std::make_tuple (node, nodeID,
-                                  firstChild, currentChild, fullBelow));
-
-                            // Switch to processing the child node
-                            node = static_cast<SHAMapInnerNode*>(d);
-                            nodeID = childID;
-                            firstChild = rand_int(255);
-                            currentChild = 0;
-                            fullBelow = true;
-                        }
+                        if (ret.size () >= max)
+                            return ret;
                     }
+
+                    fullBelow = false; // This node is not known full below
+                }
+                else if (child->isInner() &&
+                         !static_cast<SHAMapInnerNode*>(child)->isFullBelow(generation))
+                {
+                    stack.push (std::make_tuple (node, nodeID,
+                          firstChild, currentChild, fullBelow));
+
+                    // Switch to processing the child node
+                    node = static_cast<SHAMapInnerNode*>(child);
+                    nodeID = childID;
+                    firstChild = rand_int(255);
+                    currentChild = 0;
+                    fullBelow = true;
                 }
             }
 
@@ -245,61 +280,85 @@ SHAMap::getMissingNodes(std::size_t max, SHAMapSyncFilter* filter)
             }
 
         }
-        while ((node != nullptr) && (deferredReads.size () <= maxDefer));
+        while ((node != nullptr) && (deferredReads.size () < maxDefer));
 
         // If we didn't defer any reads, we're done
         if (deferredReads.empty ())
             break;
 
-        auto const before = std::chrono::steady_clock::now();
-        f_.db().waitReads();
-        auto const after = std::chrono::steady_clock::now();
+        auto const scanned = std::chrono::steady_clock::now();
 
-        auto const elapsed = std::chrono::duration_cast
-            <std::chrono::milliseconds> (after - before);
-        auto const count = deferredReads.size ();
+        std::vector<uint256> hashes;
+        hashes.reserve (deferredReads.size ());
+        for (auto const& d : deferredReads)
+            hashes.push_back (d.first.as_uint256());
+
+        auto const objects = f_.db().fetchBatch (hashes);
 
-        // Process all deferred reads
-        int hits = 0;
-        for (auto const& node : deferredReads)
+        // Report the missing nodes starting at a random position
+        // for the same reason we pick a random first child above.
+        auto iter = deferredReads.begin ();
+        std::size_t const offset = (deferredReads.size () > 1) ?
+            rand_int (deferredReads.size () - 1) : 0;
+        std::advance (iter, offset);
+
+        std::size_t hits = 0;
+        for (std::size_t n = 0; n < objects.size (); ++n)
         {
-            auto parent = std::get<0>(node);
-            auto branch = std::get<1>(node);
-            auto const& nodeID = std::get<2>(node);
-            auto const& nodeHash = parent->getChildHash (branch);
+            std::size_t const k = (offset + n) % objects.size ();
+            if (iter == deferredReads.end ())
+                iter = deferredReads.begin ();
+
+            auto const& hash = iter->first;
+            auto const& waiters = iter->second;
+            ++iter;
+
+            std::shared_ptr<SHAMapAbstractNode> ptr;
+
+            if (objects[k])
+            {
+                try
+                {
+                    ptr = SHAMapAbstractNode::make (objects[k]->getData (),
+                        0, snfPREFIX, hash, true, f_.journal ());
+                    if (ptr)
+                        canonicalize (hash, ptr);
+                }
+                catch (std::exception const&)
+                {
+                    JLOG(journal_.warn()) <<
+                        "Invalid DB node " << hash;
+                    ptr.reset ();
+                }
+            }
 
-            auto nodePtr = fetchNodeNT(nodeHash, filter);
-            if (nodePtr)
+            if (ptr)
             {
                 ++hits;
-                if (backed_)
-                    canonicalize (nodeHash, nodePtr);
-                nodePtr = parent->canonicalizeChild (branch, std::move(nodePtr));
+                for (auto const& w : waiters)
+                    std::get<0>(w)->canonicalizeChild (std::get<1>(w), ptr);
             }
-            else if ((max > 0) && (missingHashes.insert (nodeHash).second))
+            else if ((ret.size () < max) && missingHashes.insert (hash).second)
             {
-                ret.push_back (
-                    std::make_pair (
-                        nodeID,
-                        nodeHash.as_uint256()));
-
-                --max;
+                ret.emplace_back (std::get<2>(waiters.front ()),
+                    hash.as_uint256());
             }
         }
 
-        auto const process_time = std::chrono::duration_cast
-            <std::chrono::milliseconds> (std::chrono::steady_clock::now() - after);
+        auto const after = std::chrono::steady_clock::now();
 
-        if ((count > 50) || (elapsed.count() > 50))
-        {
-            JLOG(journal_.debug()) << "getMissingNodes reads " <<
-                count << " nodes (" << hits << " hits) in "
-                << elapsed.count() << " + " << process_time.count()  << " ms";
-        }
+        auto const scanTime = std::chrono::duration_cast
+            <std::chrono::milliseconds> (scanned - before);
+        auto const readTime = std::chrono::duration_cast
+            <std::chrono::milliseconds> (after - scanned);
+        auto const count = deferredReads.size ();
 
-        if (max <= 0)
-            return ret;
+        auto const stream = ((count > 50) || (readTime.count() > 50)) ?
+            journal.debug() : journal.trace();
 
+        JLOG(stream) << "getMissingNodes reads " << count <<
+            " nodes (" << hits << " hits) in " << scanTime.count() <<
+            " + " << readTime.count() << " ms";
     }
 
     if (ret.empty ())
@@ -365,10 +424,10 @@ bool SHAMap::getNodeFat (SHAMapNodeID wanted,
         stack.pop ();
 
         // Add this node to the reply
-        Serializer s;
+        ScratchSerializer s;
         node->addRaw (s, snfWIRE);
         nodeIDs.push_back (nodeID);
-        rawNodes.push_back (std::move (s.peekData()));
+        rawNodes.push_back (s.peekData());
 
         if (node->isInner())
         {
@@ -397,10 +456,10 @@ bool SHAMap::getNodeFat (SHAMapNodeID wanted,
                         else if (childNode->isInner() || fatLeaves)
                         {
                             // Just include this node
-                            Serializer s;
+                            ScratchSerializer s;
                             childNode->addRaw (s, snfWIRE);
                             nodeIDs.push_back (childID);
-                            rawNodes.push_back (std::move (s.peekData ()));
+                            rawNodes.push_back (s.peekData ());
                         }
                     }
                 }
@@ -679,7 +738,7 @@ void SHAMap::getFetchPack (SHAMap const* have, bool includeLeaves, int max,
         {
             if (includeLeaves || smn.isInner ())
             {
-                Serializer s;
+                ScratchSerializer s;
                 smn.addRaw (s, snfPREFIX);
                 func (smn.getNodeHash(), s.peekData());
 
@@ -26,6 +26,8 @@
 #include <ripple/basics/StringUtilities.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/beast/core/LexicalCast.h>
+#include <algorithm>
+#include <array>
 #include <mutex>
 
 #include <openssl/sha.h>
@@ -326,6 +328,47 @@ SHAMapTreeNode::updateHash()
     return true;
 }
 
+void
+SHAMapTreeNode::updateHashes (SHAMapTreeNode* const* nodes,
+    std::size_t count)
+{
+    std::array<beast::sha512_message, 64> messages;
+    std::array<std::array<std::uint8_t, 4>, 64> prefixes;
+    std::array<uint256, 64> hashes;
+
+    for (std::size_t i = 0; i < count; i += messages.size())
+    {
+        auto const n = std::min (messages.size(), count - i);
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            auto const node = nodes[i + j];
+            std::uint32_t prefix;
+            if (node->mType == tnTRANSACTION_NM)
+                prefix = HashPrefix::transactionID;
+            else if (node->mType == tnACCOUNT_STATE)
+                prefix = HashPrefix::leafNode;
+            else
+                prefix = HashPrefix::txNode;
+            prefixes[j] = {{
+                static_cast<std::uint8_t>(prefix >> 24),
+                static_cast<std::uint8_t>(prefix >> 16),
+                static_cast<std::uint8_t>(prefix >> 8),
+                static_cast<std::uint8_t>(prefix) }};
+
+            auto& m = messages[j];
+            m = beast::sha512_message (prefixes[j].data(), 4);
+            m.append (node->mItem->data(), node->mItem->size());
+            if (node->mType != tnTRANSACTION_NM)
+                m.append (node->mItem->key().data(), 32);
+        }
+
+        sha512HalfMulti (messages.data(), n, hashes.data());
+
+        for (std::size_t j = 0; j < n; ++j)
+            nodes[i + j]->mHash = SHAMapHash{hashes[j]};
+    }
+}
+
 void
 SHAMapInnerNode::addRaw(Serializer& s, SHANodeFormat format) const
 {
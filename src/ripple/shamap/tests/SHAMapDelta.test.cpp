@@ -0,0 +1,187 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <ripple/shamap/SHAMap.h>
+#include <ripple/shamap/SHAMapItem.h>
+#include <ripple/shamap/tests/common.h>
+#include <ripple/basics/random.h>
+#include <ripple/basics/StringUtilities.h>
+#include <ripple/beast/unit_test.h>
+
+namespace ripple {
+namespace tests {
+
+class SHAMapDelta_test : public beast::unit_test::suite
+{
+public:
+    using Differences = std::vector<std::pair<uint256, SHAMap::DeltaItem>>;
+
+    static std::shared_ptr<SHAMapItem> makeRandomAS ()
+    {
+        Serializer s;
+
+        for (int d = 0; d < 3; ++d)
+            s.add32 (rand_int<std::uint32_t>());
+
+        return std::make_shared<SHAMapItem>(
+            s.getSHA512Half(), s.peekData ());
+    }
+
+    // Gather the differences a page at a time
+    static Differences visitAll (SHAMap const& a, SHAMap const& b,
+        std::size_t pageSize)
+    {
+        Differences result;
+        boost::optional<uint256> marker;
+
+        while (true)
+        {
+            std::size_t count = 0;
+            bool const complete = a.visitDelta (b, marker,
+                [&](std::shared_ptr<SHAMapItem const> const& ours,
+                    std::shared_ptr<SHAMapItem const> const& other)
+                {
+                    if (count == pageSize)
+                        return false;
+
+                    auto const& key = ours ? ours->key () : other->key ();
+                    result.emplace_back (key, SHAMap::DeltaItem (ours, other));
+                    marker = key;
+                    ++count;
+                    return true;
+                });
+
+            if (complete)
+                break;
+        }
+
+        return result;
+    }
+
+    bool matches (SHAMap::Delta const& expected, Differences const& got)
+    {
+        if (expected.size () != got.size ())
+            return false;
+
+        auto iter = expected.begin ();
+        for (auto const& d : got)
+        {
+            if (d.first != iter->first)
+                return false;
+            if (!d.second.first != !iter->second.first)
+                return false;
+            if (!d.second.second != !iter->second.second)
+                return false;
+            if (d.second.first &&
+                    d.second.first->peekData () != iter->second.first->peekData ())
+                return false;
+            if (d.second.second &&
+                    d.second.second->peekData () != iter->second.second->peekData ())
+                return false;
+            ++iter;
+        }
+
+        return true;
+    }
+
+    void testSmall (TestFamily& f)
+    {
+        testcase ("leaf against inner");
+
+        // These differ only deep in the key, so they share a long branch
+        uint256 h1, h2;
+        h1.SetHex ("b92891fe4ef6cee585fdc6fda1e09eb4d386363158ec3321b8123e5a772c6ca8");
+        h2.SetHex ("b92891fe4ef6cee585fdc6fda2e09eb4d386363158ec3321b8123e5a772c6ca8");
+
+        SHAMap a (SHAMapType::FREE, f);
+        SHAMap b (SHAMapType::FREE, f);
+
+        a.addItem (SHAMapItem {h2, Blob (32, 2)}, false, false);
+        b.addItem (SHAMapItem {h1, Blob (32, 1)}, false, false);
+        b.addItem (SHAMapItem {h2, Blob (32, 3)}, false, false);
+
+        SHAMap::Delta expected;
+        expect (a.compare (b, expected, 100), "compare");
+        expect (matches (expected, visitAll (a, b, 100)), "forward");
+
+        expected.clear ();
+        expect (b.compare (a, expected, 100), "compare");
+        expect (matches (expected, visitAll (b, a, 1)), "reverse");
+    }
+
+    void testRandom (TestFamily& f)
+    {
+        testcase ("random maps");
+
+        SHAMap source (SHAMapType::FREE, f);
+
+        std::vector<uint256> keys;
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto item = makeRandomAS ();
+            keys.push_back (item->key ());
+            source.addItem (std::move (*item), false, false);
+        }
+
+        auto dest = source.snapShot (true);
+
+        // Delete some, change some and add some
+        for (int i = 0; i < 50; ++i)
+            dest->delItem (keys[i]);
+
+        for (int i = 50; i < 100; ++i)
+        {
+            auto item = makeRandomAS ();
+            dest->updateGiveItem (std::make_shared<SHAMapItem const> (
+                keys[i], item->peekData ()), false, false);
+        }
+
+        for (int i = 0; i < 50; ++i)
+            dest->addItem (std::move (*makeRandomAS ()), false, false);
+
+        source.setImmutable ();
+        dest->setImmutable ();
+
+        SHAMap::Delta expected;
+        expect (source.compare (*dest, expected, 100000), "compare");
+        expect (expected.size () == 150, "difference count");
+
+        expect (matches (expected, visitAll (source, *dest, 100000)), "unpaged");
+        expect (matches (expected, visitAll (source, *dest, 7)), "paged");
+
+        auto const same = source.snapShot (false);
+        expect (visitAll (source, *same, 10).empty (), "identical");
+    }
+
+    void run ()
+    {
+        beast::Journal const j; // debug journal
+        TestFamily f(j);
+
+        testSmall (f);
+        testRandom (f);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SHAMapDelta,shamap,ripple);
+
+} // tests
+} // ripple
@@ -117,6 +117,10 @@ public:
                 nullptr).isGood(), "addRootNode");
         }
 
+        // A request for fewer nodes than are missing is truncated
+        expect (destination.getMissingNodes (1, nullptr).size () == 1,
+            "getMissingNodes (1)");
+
         do
         {
             f.clock().advance(std::chrono::seconds(1));
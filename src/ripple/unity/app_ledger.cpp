@@ -41,6 +41,8 @@
 #include <ripple/app/ledger/impl/LedgerTiming.cpp>
 #include <ripple/app/ledger/impl/LocalTxs.cpp>
 #include <ripple/app/ledger/impl/OpenLedger.cpp>
+#include <ripple/app/ledger/impl/ParallelApply.cpp>
+#include <ripple/app/ledger/impl/ReplayBenchmark.cpp>
 #include <ripple/app/ledger/impl/LedgerToJson.cpp>
 #include <ripple/app/ledger/impl/TransactionAcquire.cpp>
 #include <ripple/app/ledger/impl/TransactionMaster.cpp>
@@ -22,6 +22,7 @@
 #include <ripple/app/paths/RippleState.cpp>
 #include <ripple/app/paths/AccountCurrencies.cpp>
 #include <ripple/app/paths/Credit.cpp>
+#include <ripple/app/paths/PathCache.cpp>
 #include <ripple/app/paths/Pathfinder.cpp>
 #include <ripple/app/paths/Node.cpp>
 #include <ripple/app/paths/PathRequest.cpp>
@@ -29,6 +30,7 @@
 #include <ripple/app/paths/PathState.cpp>
 #include <ripple/app/paths/RippleCalc.cpp>
 #include <ripple/app/paths/RippleLineCache.cpp>
+#include <ripple/app/paths/TrustLineGraph.cpp>
 #include <ripple/app/paths/Flow.cpp>
 #include <ripple/app/paths/impl/PaySteps.cpp>
 #include <ripple/app/paths/impl/DirectStep.cpp>
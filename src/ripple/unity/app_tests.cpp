@@ -28,6 +28,8 @@
 #include <ripple/app/tests/MultiSign.test.cpp>
 #include <ripple/app/tests/OfferStream.test.cpp>
 #include <ripple/app/tests/Offer.test.cpp>
+#include <ripple/app/tests/ParallelApply_test.cpp>
+#include <ripple/app/tests/PathBenchmark_test.cpp>
 #include <ripple/app/tests/Path_test.cpp>
 #include <ripple/app/tests/Regression_test.cpp>
 #include <ripple/app/tests/SHAMapStore_test.cpp>
@@ -35,6 +37,8 @@
 #include <ripple/app/tests/SetAuth_test.cpp>
 #include <ripple/app/tests/OversizeMeta_test.cpp>
 #include <ripple/app/tests/Taker.test.cpp>
+#include <ripple/app/tests/TransactionMaster_test.cpp>
 #include <ripple/app/tests/Transaction_ordering_test.cpp>
+#include <ripple/app/tests/TrustLineGraph_test.cpp>
 #include <ripple/app/tests/TxQ_test.cpp>
 #include <ripple/app/tests/ValidatorList_test.cpp>
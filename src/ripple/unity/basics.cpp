@@ -19,6 +19,7 @@
 
 #include <BeastConfig.h>
 
+#include <ripple/basics/impl/AllocationCounter.cpp>
 #include <ripple/basics/impl/BasicConfig.cpp>
 #include <ripple/basics/impl/CheckLibraryVersions.cpp>
 #include <ripple/basics/impl/contract.cpp>
@@ -36,6 +37,7 @@
 #include <ripple/basics/impl/Time.cpp>
 #include <ripple/basics/impl/UptimeTimer.cpp>
 
+#include <ripple/basics/tests/base_uint.test.cpp>
 #include <ripple/basics/tests/CheckLibraryVersions.test.cpp>
 #include <ripple/basics/tests/mulDiv.test.cpp>
 #include <ripple/basics/tests/contract.test.cpp>
@@ -26,6 +26,7 @@
 #include <ripple/ledger/impl/CachedSLEs.cpp>
 #include <ripple/ledger/impl/CachedView.cpp>
 #include <ripple/ledger/impl/Directory.cpp>
+#include <ripple/ledger/impl/FundsCache.cpp>
 #include <ripple/ledger/impl/OpenView.cpp>
 #include <ripple/ledger/impl/PaymentSandbox.cpp>
 #include <ripple/ledger/impl/RawStateTable.cpp>
@@ -76,6 +76,7 @@
 #include <ripple/protocol/tests/STAmount.test.cpp>
 #include <ripple/protocol/tests/STObject.test.cpp>
 #include <ripple/protocol/tests/STTx.test.cpp>
+#include <ripple/protocol/tests/tokens_test.cpp>
 #include <ripple/protocol/tests/types_test.cpp>
 #include <ripple/protocol/tests/XRPAmount.test.cpp>
 
@@ -56,6 +56,7 @@
 #include <ripple/rpc/handlers/LedgerClosed.cpp>
 #include <ripple/rpc/handlers/LedgerCurrent.cpp>
 #include <ripple/rpc/handlers/LedgerData.cpp>
+#include <ripple/rpc/handlers/LedgerDiff.cpp>
 #include <ripple/rpc/handlers/LedgerEntry.cpp>
 #include <ripple/rpc/handlers/LedgerHeader.cpp>
 #include <ripple/rpc/handlers/LedgerRequest.cpp>
@@ -26,5 +26,6 @@
 #include <ripple/shamap/impl/SHAMapSync.cpp>
 #include <ripple/shamap/impl/SHAMapTreeNode.cpp>
 #include <ripple/shamap/tests/FetchPack.test.cpp>
+#include <ripple/shamap/tests/SHAMapDelta.test.cpp>
 #include <ripple/shamap/tests/SHAMap.test.cpp>
 #include <ripple/shamap/tests/SHAMapSync.test.cpp>